@@ -0,0 +1,135 @@
+#include "ccl.h"
+#include "ctest.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+CTEST_DATA(memory) {
+  int n_a;
+  double *a_arr;
+  int n_k;
+  double *lk_arr;
+  double *fka_arr;
+};
+
+CTEST_SETUP(memory) {
+  data->n_a=20;
+  data->n_k=30;
+  data->a_arr=malloc(data->n_a*sizeof(double));
+  data->lk_arr=malloc(data->n_k*sizeof(double));
+  data->fka_arr=malloc(data->n_a*data->n_k*data->n_k*sizeof(double));
+  for(int ii=0;ii<data->n_a;ii++)
+    data->a_arr[ii]=0.05+0.95*ii/(data->n_a-1.);
+  for(int ii=0;ii<data->n_k;ii++)
+    data->lk_arr[ii]=log(1E-4)+log(1E6)*(ii+0.5)/data->n_k;
+  for(int ii=0;ii<data->n_a*data->n_k*data->n_k;ii++)
+    data->fka_arr[ii]=1.;
+}
+
+CTEST_TEARDOWN(memory) {
+  free(data->a_arr);
+  free(data->lk_arr);
+  free(data->fka_arr);
+}
+
+CTEST2(memory,f1d) {
+  int status=0;
+  ccl_f1d_t *spl=ccl_f1d_t_new(data->n_k,data->lk_arr,data->lk_arr,0,0,
+                               ccl_f1d_extrap_const,
+                               ccl_f1d_extrap_const,&status);
+  ASSERT_TRUE(status==0);
+
+  // Akima spline: x, y and four coefficient arrays
+  size_t expected=(sizeof(ccl_f1d_t)+sizeof(gsl_spline)+sizeof(gsl_interp)+
+                   (6*data->n_k+4)*sizeof(double));
+  ASSERT_EQUAL_U(expected,ccl_f1d_t_size(spl));
+  ASSERT_EQUAL_U(0,ccl_f1d_t_size(NULL));
+  ccl_f1d_t_free(spl);
+}
+
+CTEST2(memory,f2d) {
+  int status=0;
+  ccl_f2d_t *psp;
+
+  // Constant function holds no splines
+  psp=ccl_f2d_t_new(-1,NULL,-1,NULL,NULL,NULL,NULL,0,1,1,
+                    ccl_f2d_constantgrowth,0,1.,2,ccl_f2d_3,&status);
+  ASSERT_TRUE(status==0);
+  ASSERT_EQUAL_U(sizeof(ccl_f2d_t),ccl_f2d_t_size(psp));
+  ccl_f2d_t_free(psp);
+
+  // Bicubic spline: knots, values and three derivative tables
+  psp=ccl_f2d_t_new(data->n_a,data->a_arr,data->n_k,data->lk_arr,
+                    data->fka_arr,NULL,NULL,0,1,1,
+                    ccl_f2d_constantgrowth,0,1.,2,ccl_f2d_3,&status);
+  ASSERT_TRUE(status==0);
+  size_t expected=(sizeof(ccl_f2d_t)+sizeof(gsl_spline2d)+
+                   (data->n_a+data->n_k+4*data->n_a*data->n_k)*sizeof(double));
+  ASSERT_EQUAL_U(expected,ccl_f2d_t_size(psp));
+  ASSERT_EQUAL_U(0,ccl_f2d_t_size(NULL));
+  ccl_f2d_t_free(psp);
+}
+
+CTEST2(memory,f3d) {
+  int status=0;
+  ccl_f3d_t *tsp=ccl_f3d_t_new(data->n_a,data->a_arr,
+                               data->n_k,data->lk_arr,
+                               data->fka_arr,NULL,NULL,0,1,1,
+                               ccl_f2d_constantgrowth,
+                               0,1.,4,ccl_f2d_3,&status);
+  ASSERT_TRUE(status==0);
+
+  // One bicubic (k1,k2) spline per scale factor
+  size_t per_a=(sizeof(gsl_spline2d)+
+                (2*data->n_k+4*data->n_k*data->n_k)*sizeof(double));
+  size_t expected=(sizeof(ccl_f3d_t)+data->n_a*sizeof(double)+
+                   data->n_a*(sizeof(gsl_spline2d)+per_a));
+  ASSERT_EQUAL_U(expected,ccl_f3d_t_size(tsp));
+  ccl_f3d_t_free(tsp);
+}
+
+CTEST2(memory,cosmology) {
+  int status=0;
+  double mnu=0.;
+  ccl_configuration config = default_config;
+  config.transfer_function_method = ccl_bbks;
+  config.matter_power_spectrum_method = ccl_linear;
+  ccl_parameters params = ccl_parameters_create(0.25, 0.05, 0.0, 3.044, &mnu, 1,
+                                                -1.0, 0.0, 0.7, NAN, 0.8, 0.96,
+                                                2.7255, NAN, 0.71611,
+                                                -1, -1, -1,
+                                                0., 0., 1., 1., 0.,
+                                                -1, NULL, NULL, &status);
+  ASSERT_TRUE(status==0);
+  ccl_cosmology *cosmo = ccl_cosmology_create(params, config);
+  ASSERT_NOT_NULL(cosmo);
+
+  ccl_memory_report_t rep;
+  ccl_memory_report(cosmo, &rep);
+  ASSERT_EQUAL_U(0, rep.background);
+  ASSERT_EQUAL_U(0, rep.growth);
+  ASSERT_EQUAL_U(sizeof(ccl_cosmology), rep.total);
+
+  ccl_cosmology_compute_distances(cosmo, &status);
+  ASSERT_TRUE(status==0);
+  ccl_cosmology_compute_growth(cosmo, &status);
+  ASSERT_TRUE(status==0);
+
+  ccl_memory_report(cosmo, &rep);
+  ASSERT_EQUAL_U(ccl_gsl_spline_size(cosmo->data.chi)+
+                 ccl_gsl_spline_size(cosmo->data.E)+
+                 ccl_gsl_spline_size(cosmo->data.achi),
+                 rep.background);
+  ASSERT_EQUAL_U(ccl_gsl_spline_size(cosmo->data.growth)+
+                 ccl_gsl_spline_size(cosmo->data.fgrowth),
+                 rep.growth);
+  ASSERT_TRUE(rep.background > 0);
+  ASSERT_TRUE(rep.growth > 0);
+  ASSERT_EQUAL_U(0, rep.sigma);
+  ASSERT_EQUAL_U(sizeof(ccl_cosmology)+rep.params+rep.background+
+                 rep.growth+rep.sigma+rep.rsd,
+                 rep.total);
+
+  ccl_parameters_free(&(cosmo->params));
+  ccl_cosmology_free(cosmo);
+}
@@ -0,0 +1,119 @@
+#include "ccl.h"
+#include "ctest.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+CTEST(workspace, cquad) {
+  gsl_integration_cquad_workspace *w1, *w2;
+
+  w1 = ccl_workspace_get_cquad(100);
+  ASSERT_NOT_NULL(w1);
+  // Nested calls must not share the pooled workspace
+  w2 = ccl_workspace_get_cquad(100);
+  ASSERT_NOT_NULL(w2);
+  ASSERT_TRUE(w1 != w2);
+  ccl_workspace_put_cquad(w2);
+  ccl_workspace_put_cquad(w1);
+
+  // The pooled workspace is reused, unless it's too small
+  w2 = ccl_workspace_get_cquad(50);
+  ASSERT_TRUE(w1 == w2);
+  ccl_workspace_put_cquad(w2);
+  w2 = ccl_workspace_get_cquad(200);
+  ASSERT_TRUE(w2->size >= 200);
+  ccl_workspace_put_cquad(w2);
+  ccl_workspace_release();
+}
+
+CTEST(workspace, integration) {
+  gsl_integration_workspace *w1, *w2;
+
+  w1 = ccl_workspace_get_integration(100);
+  ASSERT_NOT_NULL(w1);
+  ccl_workspace_put_integration(w1);
+  w2 = ccl_workspace_get_integration(100);
+  ASSERT_TRUE(w1 == w2);
+  ccl_workspace_put_integration(w2);
+  ccl_workspace_release();
+}
+
+CTEST(workspace, spline) {
+  int ii;
+  double x[10], y[10], res;
+  gsl_interp_accel *ia1, *ia2;
+  gsl_spline *s1, *s2;
+
+  for(ii=0; ii<10; ii++) {
+    x[ii] = ii;
+    y[ii] = 2*ii;
+  }
+
+  s1 = ccl_workspace_get_spline(gsl_interp_akima, 10, &ia1);
+  ASSERT_NOT_NULL(s1);
+  ASSERT_NOT_NULL(ia1);
+  ASSERT_EQUAL(0, gsl_spline_init(s1, x, y, 10));
+  ASSERT_EQUAL(0, gsl_spline_eval_integ_e(s1, 0., 9., ia1, &res));
+  ASSERT_DBL_NEAR_TOL(81., res, 1E-10);
+  ccl_workspace_put_spline(s1, ia1);
+
+  s2 = ccl_workspace_get_spline(gsl_interp_akima, 10, &ia2);
+  ASSERT_TRUE(s1 == s2);
+  ASSERT_TRUE(ia1 == ia2);
+  ccl_workspace_put_spline(s2, ia2);
+
+  // Splines must match the number of knots exactly
+  s2 = ccl_workspace_get_spline(gsl_interp_akima, 8, &ia2);
+  ASSERT_NOT_NULL(s2);
+  ASSERT_EQUAL_U(8, s2->size);
+  ccl_workspace_put_spline(s2, ia2);
+  ccl_workspace_release();
+}
+
+CTEST(workspace, root_fsolver) {
+  gsl_root_fsolver *s1, *s2;
+
+  s1 = ccl_workspace_get_root_fsolver(gsl_root_fsolver_brent);
+  ASSERT_NOT_NULL(s1);
+  ccl_workspace_put_root_fsolver(s1);
+  s2 = ccl_workspace_get_root_fsolver(gsl_root_fsolver_brent);
+  ASSERT_TRUE(s1 == s2);
+  ccl_workspace_put_root_fsolver(s2);
+  s2 = ccl_workspace_get_root_fsolver(gsl_root_fsolver_bisection);
+  ASSERT_TRUE(s2->type == gsl_root_fsolver_bisection);
+  ccl_workspace_put_root_fsolver(s2);
+  ccl_workspace_release();
+}
+
+CTEST(workspace, doubles) {
+  int ii;
+  double *bufs[CCL_WORKSPACE_NBUF+1];
+  double *b;
+
+  // More buffers than the pool holds fall back to plain allocations
+  for(ii=0; ii<CCL_WORKSPACE_NBUF+1; ii++) {
+    bufs[ii] = ccl_workspace_get_doubles(100);
+    ASSERT_NOT_NULL(bufs[ii]);
+    bufs[ii][99] = ii;
+  }
+  for(ii=0; ii<CCL_WORKSPACE_NBUF+1; ii++)
+    ccl_workspace_put_doubles(bufs[ii]);
+
+  // Smaller requests reuse pooled buffers
+  b = ccl_workspace_get_doubles(10);
+  ASSERT_TRUE(b == bufs[0]);
+  ccl_workspace_put_doubles(b);
+  ccl_workspace_release();
+}
+
+CTEST(workspace, reserve) {
+  int status = 0;
+  double *b;
+
+  ccl_workspace_reserve(1000, 500, &status);
+  ASSERT_EQUAL(0, status);
+  b = ccl_workspace_get_doubles(500);
+  ASSERT_NOT_NULL(b);
+  ccl_workspace_put_doubles(b);
+  ccl_workspace_release_all();
+}
@@ -13,7 +13,7 @@ if(NOT FFTW_FOUND )
         URL http://www.fftw.org/fftw-${FFTWVersion}.tar.gz
         URL_MD5 ${GSLMD5}
         DOWNLOAD_NO_PROGRESS 1
-        CONFIGURE_COMMAND ./configure --prefix=${CMAKE_BINARY_DIR}/extern --enable-shared=no --with-pic=yes
+        CONFIGURE_COMMAND ./configure --prefix=${CMAKE_BINARY_DIR}/extern --enable-shared=no --with-pic=yes --enable-openmp
         BUILD_COMMAND           make -j8
         INSTALL_COMMAND         make install
         BUILD_IN_SOURCE 1)
@@ -21,4 +21,5 @@ if(NOT FFTW_FOUND )
         set(FFTW_LIBRARY_DIRS ${CMAKE_BINARY_DIR}/extern/lib/ )
         set(FFTW_INCLUDES ${CMAKE_BINARY_DIR}/extern/include/)
         set(FFTW_LIBRARIES -lfftw3)
+        set(FFTW_OMP_LIB -lfftw3_omp)
 endif()
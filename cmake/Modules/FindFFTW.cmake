@@ -7,6 +7,7 @@
 #   FFTW_FOUND               ... true if fftw is found on the system
 #   FFTW_LIBRARIES           ... full path to fftw library
 #   FFTW_INCLUDES            ... fftw include directory
+#   FFTW_OMP_LIB             ... full path to the OpenMP fftw library, if found
 #
 # The following variables will be checked by the function
 #   FFTW_USE_STATIC_LIBS    ... if true, only static libraries are found
@@ -56,6 +57,13 @@ if( FFTW_ROOT )
     PATH_SUFFIXES "lib" "lib64"
     NO_DEFAULT_PATH
   )
+  find_library(
+    FFTW_OMP_LIB
+    NAMES "fftw3_omp"
+    PATHS ${FFTW_ROOT}
+    PATH_SUFFIXES "lib" "lib64"
+    NO_DEFAULT_PATH
+  )
   #find includes
   find_path(
     FFTW_INCLUDES
@@ -103,6 +111,16 @@ else()
     FFTWL_LIB
     NAMES "fftw3l"
   )
+  find_library(
+    FFTW_OMP_LIB
+    NAMES "fftw3_omp"
+    PATHS ${PKG_FFTW_LIBRARY_DIRS} ${LIB_INSTALL_DIR}
+    NO_DEFAULT_PATH
+  )
+  find_library(
+    FFTW_OMP_LIB
+    NAMES "fftw3_omp"
+  )
   find_path(
     FFTW_INCLUDES
     NAMES "fftw3.h"
@@ -126,4 +144,5 @@ set( CMAKE_FIND_LIBRARY_SUFFIXES ${CMAKE_FIND_LIBRARY_SUFFIXES_SAV} )
 include(FindPackageHandleStandardArgs)
 find_package_handle_standard_args(FFTW DEFAULT_MSG
                                   FFTW_INCLUDES FFTW_LIBRARIES)
-mark_as_advanced(FFTW_INCLUDES FFTW_LIBRARIES FFTW_LIB FFTWF_LIB FFTWL_LIB)
+mark_as_advanced(FFTW_INCLUDES FFTW_LIBRARIES FFTW_LIB FFTWF_LIB FFTWL_LIB
+                 FFTW_OMP_LIB)
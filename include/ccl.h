@@ -41,6 +41,9 @@
 #include "ccl_halofit.h"
 #include "ccl_musigma.h"
 #include "ccl_mass_conversion.h"
+#include "ccl_memory.h"
+#include "ccl_workspace.h"
+#include "ccl_halo_profiles.h"
 
 CCL_BEGIN_DECLS
 /* add function and variable declarations here */
@@ -15,6 +15,14 @@ typedef enum ccl_species_x_label {
   ccl_species_nu_label=6,
 } ccl_species_x_label;
 
+//linear collapse threshold prescriptions
+typedef enum ccl_delta_c_t {
+  ccl_delta_c_EdS=0,
+  ccl_delta_c_EdS_approx=1,
+  ccl_delta_c_NakamuraSuto97=2,
+  ccl_delta_c_Mead16=3,
+} ccl_delta_c_t;
+
 /**
  * Normalized expansion rate at scale factor a.
  * Returns H(a)/H0 in a given cosmology.
@@ -335,6 +343,25 @@ void ccl_cosmology_distances_from_input(ccl_cosmology * cosmo, int na, double a[
  */
 void ccl_cosmology_growth_from_input(ccl_cosmology* cosmo, int na, double a[], double growth_arr[], double fgrowth_arr[], int* status);
 
+/**
+ * Store user input arrays for the background expansion and the linear growth, all sampled at the same scale factor values, in their splines.
+ * The scale factor array is shared by all the splines, and must be monotonically increasing.
+ * @param cosmo Cosmological parameters
+ * @param na integer indicating size of array a
+ * @param a scale factor at locations where the input arrays are pre-computed
+ * @param chi_a comoving distance computed at values of a
+ * @param E_a Hubble parameter dividied by H_0 as a function of a
+ * @param growth_arr Growth factor array. D(1.0) will be used for normalization.
+ * @param fgrowth_arr Growth rate array.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return void
+ */
+void ccl_cosmology_background_from_input(ccl_cosmology *cosmo, int na, double a[],
+                                         double chi_a[], double E_a[],
+                                         double growth_arr[], double fgrowth_arr[],
+                                         int *status);
+
 /**
  * Compute the growth function and a spline to be stored
  * in the cosmology structure.
@@ -345,6 +372,73 @@ void ccl_cosmology_growth_from_input(ccl_cosmology* cosmo, int na, double a[], d
  */
 void ccl_cosmology_compute_growth(ccl_cosmology * cosmo, int * status);
 
+/**
+ * Tabulate Omega_m(a) and the virial overdensity Delta_vir(a) used by
+ * halo-model ingredients, and store their splines in the cosmology
+ * structure.
+ * @param cosmo Cosmological parameters
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return void
+ */
+void ccl_cosmology_compute_halo_background(ccl_cosmology *cosmo, int *status);
+
+/**
+ * Virial overdensity from the fitting function of Bryan & Norman 1998.
+ * Requires ccl_cosmology_compute_halo_background to have been called.
+ * @param cosmo Cosmological parameters
+ * @param a scale factor, normalized to 1 for today
+ * @param label density the overdensity is defined with respect to. Available: 'critical'(0), 'matter'(1).
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return Delta_vir, the virial overdensity at scale factor a.
+ */
+double ccl_Delta_vir(ccl_cosmology *cosmo, double a, ccl_species_x_label label, int *status);
+
+/**
+ * Virial overdensity at scale factors as given in list a[0..na-1]
+ * @param cosmo Cosmological parameters
+ * @param na number of scale factors.
+ * @param a array of scale factors.
+ * @param label density the overdensity is defined with respect to.
+ * @param output array of virial overdensities.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return void
+ */
+void ccl_Delta_virs(ccl_cosmology *cosmo, int na, double a[], ccl_species_x_label label,
+                    double output[], int *status);
+
+/**
+ * Linear collapse threshold. Requires
+ * ccl_cosmology_compute_halo_background to have been called, and also
+ * ccl_cosmology_compute_growth for the Mead16 prescription.
+ * @param cosmo Cosmological parameters
+ * @param a scale factor, normalized to 1 for today
+ * @param kind threshold prescription.
+ * @param sigma8 value of sigma8 (only used by the Mead16 prescription).
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return delta_c, the linear collapse threshold at scale factor a.
+ */
+double ccl_delta_c(ccl_cosmology *cosmo, double a, ccl_delta_c_t kind,
+                   double sigma8, int *status);
+
+/**
+ * Linear collapse threshold at scale factors as given in list a[0..na-1]
+ * @param cosmo Cosmological parameters
+ * @param na number of scale factors.
+ * @param a array of scale factors.
+ * @param kind threshold prescription.
+ * @param sigma8 value of sigma8 (only used by the Mead16 prescription).
+ * @param output array of collapse thresholds.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ * @return void
+ */
+void ccl_delta_cs(ccl_cosmology *cosmo, int na, double a[], ccl_delta_c_t kind,
+                  double sigma8, double output[], int *status);
+
 CCL_END_DECLS
 
 #endif
@@ -24,6 +24,255 @@ void ccl_angular_cls_limber(ccl_cosmology *cosmo,
        int nl_out, double *l_out, double *cl_out,
        ccl_integration_t integration_method,
        int *status);
+
+/**
+ * Maximum number of power spectra in a ccl_cl_batch_t.
+ */
+#define CCL_MAX_CL_BATCH 1024
+
+/**
+ * A batch of Limber power spectra to compute together. Entry i holds the
+ * cosmology, the two tracer collections and the power spectrum of the
+ * i-th power spectrum. Typically, each entry corresponds to a different
+ * cosmology with the same tracer definitions.
+ */
+typedef struct {
+  int n_cl;
+  ccl_cosmology **cosmo;
+  ccl_cl_tracer_collection_t **trc1;
+  ccl_cl_tracer_collection_t **trc2;
+  ccl_f2d_t **psp;
+} ccl_cl_batch_t;
+
+/**
+ * Creates an empty ccl_cl_batch_t.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * @return ccl_cl_batch_t structure.
+ */
+ccl_cl_batch_t *ccl_cl_batch_t_new(int *status);
+
+/**
+ * ccl_cl_batch_t destructor. The cosmologies, tracers and power spectra
+ * are not freed.
+ */
+void ccl_cl_batch_t_free(ccl_cl_batch_t *batch);
+
+/**
+ * Adds one power spectrum to a ccl_cl_batch_t.
+ * @param batch ccl_cl_batch_t to add to.
+ * @param cosmo Cosmological parameters
+ * @param trc1 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param trc2 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param psp the p2d_t object representing the 3D power spectrum to integrate over.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+void ccl_add_cl_batch(ccl_cl_batch_t *batch,
+                      ccl_cosmology *cosmo,
+                      ccl_cl_tracer_collection_t *trc1,
+                      ccl_cl_tracer_collection_t *trc2,
+                      ccl_f2d_t *psp, int *status);
+
+/**
+ * Computes the Limber power spectra of all entries of a batch at the
+ * same multipoles. All (entry, multipole) pairs are distributed over the
+ * threads of a single OpenMP region, which scales better than computing
+ * each entry in turn when there are few multipoles per entry.
+ * @param batch ccl_cl_batch_t holding the power spectra to compute.
+ * @param nl_out number of multipoles on which the power spectra will be calculated.
+ * @param l_out multipole values on which the power spectra will be calculated.
+ * @param cl_out will hold the calculated power spectra. Should have size batch->n_cl * nl_out, with the multipole being the fastest varying variable.
+ * @param integration_method method for integration over k (spline or QAG/QUAD).
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_angular_cls_limber_batch(ccl_cl_batch_t *batch,
+                                  int nl_out, double *l_out,
+                                  double *cl_out,
+                                  ccl_integration_t integration_method,
+                                  int *status);
+
+/**
+ * Computes the Limber power spectrum of two tracers including the
+ * second-order correction of the extended Limber approximation
+ * (LoVerde & Afshordi 2008). The correction depends on the second and third
+ * derivatives with respect to comoving distance of the radial kernels,
+ * transfer functions and power spectrum, which are computed with finite
+ * differences at each node of the leading-order integral. It is accurate
+ * up to terms of order (l+1/2)^-4. Contributions with derivatives of the
+ * Bessel functions (e.g. redshift-space distortions) are kept at leading
+ * order.
+ * @param cosmo Cosmological parameters
+ * @param trc1 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param trc2 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param psp the p2d_t object representing the 3D power spectrum to integrate over.
+ * @param nl_out number of multipoles on which the power spectrum will be calculated.
+ * @param l_out multipole values on which the power spectrum will be calculated.
+ * @param cl_out will hold the calculated power spectrum values.
+ * @param integration_method method for integration over k (spline or QAG/QUAD).
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_angular_cls_limber_extended(ccl_cosmology *cosmo,
+                                     ccl_cl_tracer_collection_t *trc1,
+                                     ccl_cl_tracer_collection_t *trc2,
+                                     ccl_f2d_t *psp,
+                                     int nl_out, double *l_out,
+                                     double *cl_out,
+                                     ccl_integration_t integration_method,
+                                     int *status);
+
+/**
+ * Bandpower windows projected onto the multipoles at which power spectra
+ * are computed. Bandpower b is sum_i w[b*n_ell+i] * C(ell[i]).
+ */
+typedef struct {
+  int n_bpw;
+  int n_ell;
+  double *ell;
+  double *w;
+} ccl_bandpowers_t;
+
+/**
+ * Creates a ccl_bandpowers_t from a sparse matrix of bandpower windows
+ * W_b(l), stored in compressed sparse row format. If n_sample is not
+ * positive, or not smaller than the number of multipoles with non-zero
+ * weights, power spectra are computed at each of these multipoles.
+ * Otherwise they are computed at n_sample multipoles, evenly spaced in
+ * log(l+1), and interpolated with a cubic spline.
+ * @param n_bpw number of bandpowers.
+ * @param bpw_start non-zero entries of bandpower b are bpw_start[b] to bpw_start[b+1]-1 (n_bpw+1 elements).
+ * @param ell_nz multipole of each non-zero entry.
+ * @param w_nz weight of each non-zero entry.
+ * @param n_sample number of multipoles to sample (<=0 for all of them, >=4 otherwise).
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * @return ccl_bandpowers_t structure.
+ */
+ccl_bandpowers_t *ccl_bandpowers_t_new(int n_bpw, int *bpw_start,
+                                       int *ell_nz, double *w_nz,
+                                       int n_sample, int *status);
+
+/**
+ * ccl_bandpowers_t destructor.
+ */
+void ccl_bandpowers_t_free(ccl_bandpowers_t *bpw);
+
+/**
+ * Computes Limber bandpowers for two different tracers. The power spectrum
+ * is only computed at the multipoles held by bpw, and convolved with the
+ * windows.
+ * @param cosmo Cosmological parameters
+ * @param trc1 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param trc2 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param psp the p2d_t object representing the 3D power spectrum to integrate over.
+ * @param bpw bandpower windows.
+ * @param bpw_out will hold the bpw->n_bpw bandpowers.
+ * @param integration_method method for integration over k (spline or QAG/QUAD).
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_angular_cls_limber_bandpowers(ccl_cosmology *cosmo,
+                                       ccl_cl_tracer_collection_t *trc1,
+                                       ccl_cl_tracer_collection_t *trc2,
+                                       ccl_f2d_t *psp,
+                                       ccl_bandpowers_t *bpw,
+                                       double *bpw_out,
+                                       ccl_integration_t integration_method,
+                                       int *status);
+
+/**
+ * Maximum number of pairs of tracers in a ccl_data_vector_t.
+ */
+#define CCL_MAX_DATA_VECTOR_PAIRS 1024
+
+/**
+ * Definition of a data vector made of angular power spectra and
+ * correlation functions. Entry i holds the two tracer collections of the
+ * i-th element, its type (0 for a power spectrum, or one of the
+ * CCL_CORR_* correlation types) and its scale cuts: only multipoles (or
+ * angles in degrees) between x_min[i] and x_max[i] are kept.
+ */
+typedef struct {
+  int n_pairs;
+  ccl_cl_tracer_collection_t **trc1;
+  ccl_cl_tracer_collection_t **trc2;
+  int *corr_type;
+  double *x_min;
+  double *x_max;
+} ccl_data_vector_t;
+
+/**
+ * Creates an empty ccl_data_vector_t.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * @return ccl_data_vector_t structure.
+ */
+ccl_data_vector_t *ccl_data_vector_t_new(int *status);
+
+/**
+ * ccl_data_vector_t destructor. The tracers are not freed.
+ */
+void ccl_data_vector_t_free(ccl_data_vector_t *dv);
+
+/**
+ * Adds an element to a ccl_data_vector_t.
+ * @param dv data vector definition.
+ * @param trc1 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param trc2 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param corr_type 0 for a power spectrum, or the type of correlation function (CCL_CORR_GG, CCL_CORR_GL, CCL_CORR_LP or CCL_CORR_LM).
+ * @param x_min smallest multipole (or angle in degrees) kept.
+ * @param x_max largest multipole (or angle in degrees) kept.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+void ccl_add_data_vector_pair(ccl_data_vector_t *dv,
+                              ccl_cl_tracer_collection_t *trc1,
+                              ccl_cl_tracer_collection_t *trc2,
+                              int corr_type, double x_min, double x_max,
+                              int *status);
+
+/**
+ * Size of a data vector after scale cuts.
+ * @param dv data vector definition.
+ * @param n_ell number of multipoles of the power spectra.
+ * @param ell multipoles of the power spectra.
+ * @param n_theta number of angles of the correlation functions.
+ * @param theta angles of the correlation functions in degrees.
+ * @return number of elements.
+ */
+int ccl_data_vector_t_size(ccl_data_vector_t *dv,
+                           int n_ell, double *ell,
+                           int n_theta, double *theta);
+
+/**
+ * Computes a data vector of Limber power spectra and correlation
+ * functions in one pass. Power spectra and correlation functions are
+ * evaluated at the multipoles and angles that pass the scale cuts of each
+ * element, and stored one element after another. Correlation functions
+ * are computed with FFTLog from power spectra sampled at ell_sample.
+ * Elements sharing the same tracers share their sampled power spectrum,
+ * and all correlation functions with the same Bessel order are
+ * transformed together.
+ * @param cosmo Cosmological parameters
+ * @param psp the p2d_t object representing the 3D power spectrum to integrate over.
+ * @param dv data vector definition.
+ * @param n_ell number of multipoles of the power spectra.
+ * @param ell multipoles of the power spectra.
+ * @param n_theta number of angles of the correlation functions.
+ * @param theta angles of the correlation functions in degrees.
+ * @param n_ell_sample number of multipoles at which power spectra are sampled for correlation functions.
+ * @param ell_sample increasing multipoles at which power spectra are sampled for correlation functions.
+ * @param dv_out will hold the data vector, of size ccl_data_vector_t_size.
+ * @param integration_method method for integration over k (spline or QAG/QUAD).
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_angular_data_vector_limber(ccl_cosmology *cosmo, ccl_f2d_t *psp,
+                                    ccl_data_vector_t *dv,
+                                    int n_ell, double *ell,
+                                    int n_theta, double *theta,
+                                    int n_ell_sample, double *ell_sample,
+                                    double *dv_out,
+                                    ccl_integration_t integration_method,
+                                    int *status);
+
 /**
  * Computes non-Limber power spectrum for two different tracers at a given ell.
  * @param cosmo Cosmological parameters
@@ -76,5 +325,102 @@ void ccl_angular_cl_covariance(ccl_cosmology *cosmo,
                                ccl_integration_t integration_method,
                                int chi_exponent, ccl_f1d_t *kernel_extra,
                                double prefactor_extra, int *status);
+
+/**
+ * Computes the Gaussian (Knox) covariance between a set of angular power
+ * spectra of n_tr tracers:
+ * Cov(C^{ab}_l, C^{cd}_l) = [S^{ac}_l S^{bd}_l + S^{ad}_l S^{bc}_l] /
+ * [(2l+1) f_sky Delta_l], with S = C + N. The covariance vanishes for
+ * different multipoles, so only its diagonal in ell is stored.
+ * @param n_tr number of tracers.
+ * @param n_ell number of multipoles (or bandpowers).
+ * @param ell multipole values.
+ * @param delta_ell width of each bandpower. If NULL, unit widths are used.
+ * @param cl power spectra of all tracer pairs, stored as cl[(i*n_tr+j)*n_ell+il].
+ * @param noise noise power spectra with the same layout as cl. May be NULL.
+ * @param fsky sky fraction.
+ * @param n_pairs number of power spectra in the data vector.
+ * @param pair_i index of the first tracer of each power spectrum.
+ * @param pair_j index of the second tracer of each power spectrum.
+ * @param cov_out will hold the covariance, stored as cov_out[(p*n_pairs+q)*n_ell+il].
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_angular_cl_covariance_gaussian(int n_tr, int n_ell,
+                                        double *ell, double *delta_ell,
+                                        double *cl, double *noise,
+                                        double fsky,
+                                        int n_pairs, int *pair_i, int *pair_j,
+                                        double *cov_out, int *status);
+
+/**
+ * Maximum number of parameters in a ccl_cl_derivs_t.
+ */
+#define CCL_MAX_CL_DERIVS 100
+
+/**
+ * Derivatives of the ingredients of a Limber integral with respect to a
+ * set of parameters. For parameter i, dtrc1[i] and dtrc2[i] hold the
+ * derivatives of the radial kernels of both tracer collections, and
+ * dpsp[i] that of the power spectrum, all at fixed wavenumber and
+ * comoving distance. NULL entries are treated as zero.
+ */
+typedef struct {
+  int n_par;
+  ccl_cl_tracer_collection_t **dtrc1;
+  ccl_cl_tracer_collection_t **dtrc2;
+  ccl_f2d_t **dpsp;
+} ccl_cl_derivs_t;
+
+/**
+ * Creates an empty ccl_cl_derivs_t.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * @return ccl_cl_derivs_t structure.
+ */
+ccl_cl_derivs_t *ccl_cl_derivs_t_new(int *status);
+
+/**
+ * ccl_cl_derivs_t destructor. The derivatives themselves are not freed.
+ */
+void ccl_cl_derivs_t_free(ccl_cl_derivs_t *derivs);
+
+/**
+ * Adds one parameter to a ccl_cl_derivs_t.
+ * @param derivs ccl_cl_derivs_t to add to.
+ * @param dtrc1 derivative of the first tracer collection (or NULL).
+ * @param dtrc2 derivative of the second tracer collection (or NULL).
+ * @param dpsp derivative of the power spectrum (or NULL).
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+void ccl_add_cl_deriv(ccl_cl_derivs_t *derivs,
+                      ccl_cl_tracer_collection_t *dtrc1,
+                      ccl_cl_tracer_collection_t *dtrc2,
+                      ccl_f2d_t *dpsp, int *status);
+
+/**
+ * Computes the derivatives of the Limber power spectrum of two tracers
+ * with respect to a set of parameters in a single pass. The derivatives
+ * of the radial kernels and of the power spectrum are propagated through
+ * the Limber integral, sharing the quadrature nodes (those of the spline
+ * integration method) and the evaluation of the base quantities across
+ * all parameters. Transfer functions are assumed parameter-independent.
+ * @param cosmo Cosmological parameters
+ * @param trc1 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param trc2 a ccl_cl_tracer_collection_t containing a bunch of individual contributions.
+ * @param psp the p2d_t object representing the 3D power spectrum to integrate over.
+ * @param derivs derivatives of the tracers and power spectrum.
+ * @param nl_out number of multipoles on which the derivatives will be calculated.
+ * @param l_out multipole values on which the derivatives will be calculated.
+ * @param dcl_out will hold the derivatives. Should have size derivs->n_par * nl_out, with the multipole being the fastest varying variable.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * For specific cases see documentation for ccl_error.c
+ */
+void ccl_angular_cls_limber_derivs(ccl_cosmology *cosmo,
+                                   ccl_cl_tracer_collection_t *trc1,
+                                   ccl_cl_tracer_collection_t *trc2,
+                                   ccl_f2d_t *psp,
+                                   ccl_cl_derivs_t *derivs,
+                                   int nl_out, double *l_out,
+                                   double *dcl_out, int *status);
 CCL_END_DECLS
 #endif
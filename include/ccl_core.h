@@ -259,6 +259,11 @@ typedef struct ccl_data {
   gsl_spline * E;
   gsl_spline * achi;
 
+  // Halo-model background: Omega_m(a) and the virial overdensity
+  // (Bryan & Norman 1998) with respect to the critical density
+  gsl_spline * Om;
+  gsl_spline * Delta_vir;
+
   // Function of Halo mass M
   gsl_spline2d * logsigma;
 
@@ -280,6 +285,7 @@ typedef struct ccl_cosmology {
   bool computed_distances;
   bool computed_growth;
   bool computed_sigma;
+  bool computed_halo_background;
 
   int status;
   //this is optional - less tedious than tracking all numerical values for status in error handler function
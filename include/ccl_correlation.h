@@ -79,6 +79,26 @@ void ccl_correlation_pi_sigma(ccl_cosmology *cosmo,ccl_f2d_t *psp,
                               int n_sig,double *sig,double *xi,
                               int use_spline,int *status);
 
+/**
+ * Computes the projected correlation function
+ * wp(rp) = 2 \int_0^{\pi_{max}} d\pi\,\xi(\sqrt{r_p^2+\pi^2},\mu)
+ * at several scale factors, using a single FFTLog transform for all of them.
+ * @param cosmo :Cosmological parameters
+ * @param psp: power spectrum
+ * @param n_a : number of scale factors
+ * @param a : scale factors
+ * @param beta : growth rate over bias at each scale factor, used to include linear RSDs. NULL for no RSDs.
+ * @param pi_max : maximum line-of-sight separation in Mpc. Use pi_max <= 0 for an infinite integral, in which case beta is not used.
+ * @param n_rp : number of output values of rp
+ * @param rp : values of the projected separation in Mpc
+ * @param wp : output projected correlation function, in Mpc, with wp[ia*n_rp+ir] for a[ia] and rp[ir]. Should be pre-allocated.
+ * @param status : Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+void ccl_correlation_projected(ccl_cosmology *cosmo,ccl_f2d_t *psp,
+                               int n_a,double *a,double *beta,
+                               double pi_max,int n_rp,double *rp,
+                               double *wp,int *status);
+
 CCL_END_DECLS
 
 #endif
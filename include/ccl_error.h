@@ -46,6 +46,7 @@ CCL_BEGIN_DECLS
 #define CCL_ERROR_SIGMA_INIT 1062
 #define CCL_ERROR_HMF_INIT 1063
 #define CCL_ERROR_OVERWRITE 1064
+#define CCL_ERROR_HALO_BACKGROUND_INIT 1065
 
 typedef enum {
   CCL_DEBUG_MODE_OFF = 0,
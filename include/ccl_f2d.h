@@ -77,6 +77,25 @@ ccl_f2d_t *ccl_f2d_t_new(int na,double *a_arr,
 			 ccl_f2d_interp_t interp_type,
 			 int *status);
 
+/**
+ * Create a ccl_f2d_t structure holding a power spectrum, interpolated
+ * in log(P) and extrapolated to early times with the CCL growth factor.
+ * @param na number of elements in a_arr.
+ * @param a_arr array of scale factor values. The array should be ordered.
+ * @param nk number of elements of lk_arr.
+ * @param lk_arr array of logarithmic wavenumbers. The array should be ordered.
+ * @param pk_arr array of size na * nk containing P(k,a) (NOT its logarithm), with pk_arr[ia*nk+ik] = P(k=exp(lk_arr[ik]),a=a_arr[ia]). All values must be positive.
+ * @param extrap_order_lok Order of the polynomial that extrapolates on wavenumbers smaller than the minimum of lk_arr.
+ * @param extrap_order_hik Order of the polynomial that extrapolates on wavenumbers larger than the maximum of lk_arr.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+ccl_f2d_t *ccl_f2d_t_new_from_pk(int na, double *a_arr,
+                                 int nk, double *lk_arr,
+                                 double *pk_arr,
+                                 int extrap_order_lok,
+                                 int extrap_order_hik,
+                                 int *status);
+
 /**
  * Evaluate 2D function of k and a defined by ccl_f2d_t structure.
  * @param fka ccl_f2d_t structure defining f(k,a).
@@ -0,0 +1,119 @@
+/** @file */
+#ifndef __CCL_HALO_PROFILES_H_INCLUDED__
+#define __CCL_HALO_PROFILES_H_INCLUDED__
+
+CCL_BEGIN_DECLS
+
+/**
+ * Tabulate the dimensionless Fourier-space template of the generalized
+ * NFW pressure profile,
+ *   F(q) = \int_0^{x_out} dx x^2 p(x) j_0(q x),
+ * where p(x) = (c500 x)^{-gamma} [1+(c500 x)^alpha]^{(gamma-beta)/alpha},
+ * using a single FFTLog transform.
+ * @param alpha profile shape parameter.
+ * @param beta profile shape parameter.
+ * @param gamma profile shape parameter.
+ * @param c500 concentration parameter.
+ * @param x_out profile truncation radius in units of r_500c (may be infinite).
+ * @param padding_lo factor by which the FFTLog grid extends below 1/q_max.
+ * @param padding_hi factor by which the FFTLog grid extends above 1/q_min.
+ * @param n_per_decade number of FFTLog samples per decade.
+ * @param nq number of values of q.
+ * @param q_arr values of q, in increasing order.
+ * @param fq_arr output values of F(q).
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+void ccl_gnfw_fourier_table(double alpha, double beta, double gamma,
+                            double c500, double x_out,
+                            double padding_lo, double padding_hi,
+                            double n_per_decade,
+                            int nq, double *q_arr, double *fq_arr,
+                            int *status);
+
+/**
+ * Tabulate the dimensionless Fourier-space and projected templates of
+ * the Einasto profile, with shape e(x) = exp(-2 (x^alpha-1)/alpha),
+ *   F(q) = \int_0^\infty dx x^2 e(x) j_0(q x),
+ *   S(X) = 2 \int_0^\infty dz e(\sqrt{z^2+X^2}),
+ * for several values of alpha, using one FFTLog pass for each.
+ * @param nalpha number of values of alpha.
+ * @param alpha_arr values of alpha.
+ * @param padding_lo factor by which the FFTLog grid extends below 1/q_max
+ *        and X_min.
+ * @param padding_hi factor by which the FFTLog grid extends above 1/q_min
+ *        and X_max.
+ * @param n_per_decade number of FFTLog samples per decade.
+ * @param nq number of values of q.
+ * @param q_arr values of q, in increasing order.
+ * @param fq_arr output values of F(q), with shape [nalpha][nq].
+ * @param nx number of values of X. If 0, S(X) is not computed.
+ * @param x_arr values of X, in increasing order.
+ * @param sx_arr output values of S(X), with shape [nalpha][nx].
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+void ccl_einasto_tables(int nalpha, double *alpha_arr,
+                        double padding_lo, double padding_hi,
+                        double n_per_decade,
+                        int nq, double *q_arr, double *fq_arr,
+                        int nx, double *x_arr, double *sx_arr,
+                        int *status);
+
+/**
+ * Hernquist profile quantities computed by ccl_hernquist_profile.
+ */
+typedef enum ccl_hernquist_profile_t {
+  ccl_hernquist_real=0,      //!< rho(r)
+  ccl_hernquist_projected=1, //!< Sigma(R)
+  ccl_hernquist_cumul2d=2,   //!< Sigma(<R)
+  ccl_hernquist_fourier=3,   //!< rho(k)
+} ccl_hernquist_profile_t;
+
+/**
+ * Evaluate the Hernquist profile,
+ *   rho(r) = rho_0 / [x (1+x)^3], x = r/r_s,
+ * normalized so that the mass within r = c r_s is M, or one of its
+ * projected or Fourier-space counterparts, for several halos at once.
+ * @param kind quantity to compute.
+ * @param truncated if nonzero, the profile vanishes beyond r = c r_s.
+ * Only supported for the real-space and Fourier-space profiles.
+ * @param nM number of halos.
+ * @param M_arr halo masses.
+ * @param rs_arr halo scale radii.
+ * @param c_arr halo concentrations.
+ * @param nr number of radii (or wavenumbers).
+ * @param r_arr radii (or wavenumbers), in the same units as rs_arr.
+ * @param prof output values, in an array of size nM * nr, with the
+ * radius index running fastest.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+void ccl_hernquist_profile(ccl_hernquist_profile_t kind, int truncated,
+                           int nM, double *M_arr, double *rs_arr,
+                           double *c_arr, int nr, double *r_arr,
+                           double *prof, int *status);
+
+/**
+ * Mass integral of the outer product of two sets of Fourier-space
+ * profiles,
+ *   I(k_i,k'_j) = \sum_m w_m u_1(k_i|M_m) u_2(k'_j|M_m),
+ * where the weights w_m combine the mass function (and halo bias) with
+ * the quadrature weights of the mass integral.
+ * @param nM number of masses.
+ * @param w_arr integration weights.
+ * @param nk1 number of wavenumbers of the first profile.
+ * @param u1_arr first profile, in an array of size nk1 * nM with the
+ * mass index running fastest.
+ * @param nk2 number of wavenumbers of the second profile.
+ * @param u2_arr second profile, in an array of size nk2 * nM with the
+ * mass index running fastest.
+ * @param out output integrals, in an array of size nk1 * nk2 with the
+ * index of k' running fastest.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+void ccl_halomod_mass_outer(int nM, double *w_arr,
+                            int nk1, double *u1_arr,
+                            int nk2, double *u2_arr,
+                            double *out, int *status);
+
+CCL_END_DECLS
+
+#endif
@@ -18,6 +18,30 @@ void ccl_convert_concentration(ccl_cosmology *cosmo,
 			       double delta_old, int nc, double c_old[],
 			       double delta_new, double c_new[],int *status);
 
+/**
+ * Tabulate the translation of halo masses between two mass definitions,
+ * assuming an NFW profile, for a grid of masses and scale factors.
+ * @param cosmo Cosmological parameters
+ * @param na number of scale factors.
+ * @param d_factor_arr ratio Delta_old Omega_old / (Delta_new Omega_new)
+ * of the overdensities of both mass definitions, in units of the critical
+ * density, at each scale factor.
+ * @param nM number of masses (at least 2).
+ * @param lM_arr natural logarithm of the input masses, in increasing order.
+ * @param c_old_arr concentrations of the input masses, in an array of size
+ * na * nM with the mass index running fastest.
+ * @param lM_new_arr output natural logarithm of the translated masses,
+ * with the same layout as c_old_arr.
+ * @param jac_arr output Jacobian dlog(M_new)/dlog(M_old), with the same
+ * layout as c_old_arr.
+ * @param status Status flat. 0 if everything went well.
+ */
+void ccl_mass_translation_table(ccl_cosmology *cosmo,
+				int na, double *d_factor_arr,
+				int nM, double *lM_arr, double *c_old_arr,
+				double *lM_new_arr, double *jac_arr,
+				int *status);
+
 CCL_END_DECLS
 
 #endif
@@ -0,0 +1,87 @@
+/** @file */
+#ifndef __CCL_MEMORY_H_INCLUDED__
+#define __CCL_MEMORY_H_INCLUDED__
+
+#include <gsl/gsl_spline.h>
+#include <gsl/gsl_spline2d.h>
+
+CCL_BEGIN_DECLS
+
+/**
+ * Struct holding the memory footprint (in bytes) of a ccl_cosmology,
+ * broken down by component.
+ */
+typedef struct {
+  size_t params; /**< ccl_parameters arrays (neutrino masses, modified growth) */
+  size_t background; /**< chi(a), a(chi), E(a), Omega_m(a) and Delta_vir(a) splines */
+  size_t growth; /**< Growth factor and growth rate splines */
+  size_t sigma; /**< sigma(M,a) spline */
+  size_t rsd; /**< Redshift-space correlation function splines */
+  size_t total; /**< Sum of all the above, plus the ccl_cosmology struct itself */
+} ccl_memory_report_t;
+
+/**
+ * Return the number of bytes held by a GSL 1D spline, including its
+ * knots and the coefficient arrays of the interpolator.
+ * @param spl GSL spline (may be NULL).
+ * @return size in bytes.
+ */
+size_t ccl_gsl_spline_size(gsl_spline *spl);
+
+/**
+ * Return the number of bytes held by a GSL 2D spline, including its
+ * knots, values and the coefficient arrays of the interpolator.
+ * @param spl GSL 2D spline (may be NULL).
+ * @return size in bytes.
+ */
+size_t ccl_gsl_spline2d_size(gsl_spline2d *spl);
+
+/**
+ * Return the number of bytes held by a ccl_f1d_t structure.
+ * @param spl ccl_f1d_t structure (may be NULL).
+ * @return size in bytes.
+ */
+size_t ccl_f1d_t_size(ccl_f1d_t *spl);
+
+/**
+ * Return the number of bytes held by a ccl_f2d_t structure.
+ * @param f2d ccl_f2d_t structure (may be NULL).
+ * @return size in bytes.
+ */
+size_t ccl_f2d_t_size(ccl_f2d_t *f2d);
+
+/**
+ * Return the number of bytes held by a ccl_f3d_t structure.
+ * @param f3d ccl_f3d_t structure (may be NULL).
+ * @return size in bytes.
+ */
+size_t ccl_f3d_t_size(ccl_f3d_t *f3d);
+
+/**
+ * Return the number of bytes held by a ccl_cl_tracer_t structure.
+ * @param tr tracer (may be NULL).
+ * @return size in bytes.
+ */
+size_t ccl_cl_tracer_t_size(ccl_cl_tracer_t *tr);
+
+/**
+ * Return the number of bytes held by a tracer collection, including
+ * all the tracers it contains.
+ * @param trc collection of tracers (may be NULL).
+ * @return size in bytes.
+ */
+size_t ccl_cl_tracer_collection_t_size(ccl_cl_tracer_collection_t *trc);
+
+/**
+ * Fill a ccl_memory_report_t with the memory footprint of a cosmology.
+ * Only data owned by the ccl_cosmology structure is accounted for.
+ * Power spectra and tracers live in separate objects, and should be
+ * measured with ccl_f2d_t_size and friends.
+ * @param cosmo Cosmology structure.
+ * @param report output memory report.
+ */
+void ccl_memory_report(ccl_cosmology *cosmo, ccl_memory_report_t *report);
+
+CCL_END_DECLS
+
+#endif
@@ -58,6 +58,25 @@ ccl_cl_tracer_t *ccl_cl_tracer_t_new(ccl_cosmology *cosmo,
 				     int extrap_order_hik,
 				     int *status);
 
+/**
+ * Creates a new tracer sharing the Bessel and angular derivative orders
+ * and a copy of the transfer function of an existing one, but with a
+ * different radial kernel. Useful to represent derivatives of the
+ * radial kernel with respect to model parameters.
+ * @param cosmo Cosmological parameters.
+ * @param tr tracer to copy.
+ * @param n_w number of values of the comoving distance sampling the new kernel.
+ * @param chi_w values of the radial comoving distance for the new kernel.
+ * @param w_w corresponding values of the new radial kernel.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ * @return ccl_cl_tracer_t structure.
+ */
+ccl_cl_tracer_t *ccl_cl_tracer_t_new_with_kernel(ccl_cosmology *cosmo,
+						 ccl_cl_tracer_t *tr,
+						 int n_w,double *chi_w,
+						 double *w_w,
+						 int *status);
+
 /**
  * ccl_tracer_t_free destructor
  */
@@ -169,6 +188,8 @@ void ccl_get_kappa_kernel(ccl_cosmology *cosmo,
 typedef struct {
   int n_tracers; //Number of tracers in this collection
   ccl_cl_tracer_t **ts; //Array of tracers
+  double chi_min; //Lowest chi_min of all tracers
+  double chi_max; //Highest chi_max of all tracers
 } ccl_cl_tracer_collection_t;
 
 /**
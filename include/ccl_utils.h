@@ -47,6 +47,18 @@ double * ccl_log_spacing(double xmin, double xmax, int N);
 double ccl_j_bessel(int l,double x);
 //Spherical Bessel function of order l (adapted from CAMB)
 
+/**
+ * Compute the spherical Bessel functions j_l(x) of all orders up to l_max
+ * on an array of arguments, using recurrence relations.
+ * @param l_max maximum order.
+ * @param nx number of arguments.
+ * @param x arguments.
+ * @param jl output array of size (l_max+1)*nx, with jl[l*nx+ix] = j_l(x[ix]).
+ * @param status status flag.
+ */
+void ccl_j_bessel_array(int l_max, int nx, double *x, double *jl,
+                        int *status);
+
 /**
  * Compute spline integral.
  * @param nx number of elements in input array.
@@ -0,0 +1,123 @@
+/** @file */
+#ifndef __CCL_WORKSPACE_H_INCLUDED__
+#define __CCL_WORKSPACE_H_INCLUDED__
+
+#include <gsl/gsl_integration.h>
+#include <gsl/gsl_roots.h>
+#include <gsl/gsl_spline.h>
+
+CCL_BEGIN_DECLS
+
+/**
+ * Number of scratch buffers of doubles held by each thread's pool.
+ */
+#define CCL_WORKSPACE_NBUF 4
+
+/*
+ * Per-thread pool of GSL workspaces and scratch buffers.
+ *
+ * Every OpenMP thread owns one pool holding at most one object of each
+ * kind (and CCL_WORKSPACE_NBUF buffers). A routine takes an object with
+ * ccl_workspace_get_* and hands it back with the matching
+ * ccl_workspace_put_* once it is done with it. If the pooled object is
+ * already in use (e.g. by a caller further up the stack), or if it is
+ * too small, a fresh one is allocated, so pooled objects are never
+ * shared. Objects handed back stay allocated until ccl_workspace_release
+ * is called, which should happen at the end of each compute_* call.
+ */
+
+/**
+ * Get a QAG integration workspace with at least n intervals.
+ * @param n number of intervals.
+ * @return workspace, or NULL if it could not be allocated.
+ */
+gsl_integration_workspace *ccl_workspace_get_integration(size_t n);
+
+/**
+ * Hand back a workspace obtained with ccl_workspace_get_integration.
+ * @param w workspace (may be NULL).
+ */
+void ccl_workspace_put_integration(gsl_integration_workspace *w);
+
+/**
+ * Get a CQUAD integration workspace with at least n intervals.
+ * @param n number of intervals.
+ * @return workspace, or NULL if it could not be allocated.
+ */
+gsl_integration_cquad_workspace *ccl_workspace_get_cquad(size_t n);
+
+/**
+ * Hand back a workspace obtained with ccl_workspace_get_cquad.
+ * @param w workspace (may be NULL).
+ */
+void ccl_workspace_put_cquad(gsl_integration_cquad_workspace *w);
+
+/**
+ * Get an uninitialized GSL spline of type T with n knots, together
+ * with a reset interpolation accelerator.
+ * @param T interpolation type.
+ * @param n number of knots.
+ * @param ia output accelerator.
+ * @return spline, or NULL if it could not be allocated.
+ */
+gsl_spline *ccl_workspace_get_spline(const gsl_interp_type *T, size_t n,
+                                     gsl_interp_accel **ia);
+
+/**
+ * Hand back a spline and accelerator obtained with
+ * ccl_workspace_get_spline.
+ * @param s spline (may be NULL).
+ * @param ia accelerator (may be NULL).
+ */
+void ccl_workspace_put_spline(gsl_spline *s, gsl_interp_accel *ia);
+
+/**
+ * Get a GSL root solver of type T.
+ * @param T solver type.
+ * @return solver, or NULL if it could not be allocated.
+ */
+gsl_root_fsolver *ccl_workspace_get_root_fsolver(const gsl_root_fsolver_type *T);
+
+/**
+ * Hand back a solver obtained with ccl_workspace_get_root_fsolver.
+ * @param s solver (may be NULL).
+ */
+void ccl_workspace_put_root_fsolver(gsl_root_fsolver *s);
+
+/**
+ * Get an uninitialized scratch buffer of at least n doubles.
+ * @param n number of elements.
+ * @return buffer, or NULL if it could not be allocated.
+ */
+double *ccl_workspace_get_doubles(size_t n);
+
+/**
+ * Hand back a buffer obtained with ccl_workspace_get_doubles.
+ * @param buf buffer (may be NULL).
+ */
+void ccl_workspace_put_doubles(double *buf);
+
+/**
+ * Allocate the integration workspaces and scratch buffers of every
+ * thread up front, so that the first calls do not pay for them.
+ * @param n_intervals number of intervals of the QAG and CQUAD workspaces.
+ * @param n_doubles size of each scratch buffer.
+ * @param status Status flag. 0 if there are no errors, nonzero otherwise.
+ */
+void ccl_workspace_reserve(size_t n_intervals, size_t n_doubles, int *status);
+
+/**
+ * Free everything held by the calling thread's pool. Objects that have
+ * not been handed back are left untouched.
+ */
+void ccl_workspace_release(void);
+
+/**
+ * Free everything held by the pools of all threads. Must not be called
+ * from within a parallel region.
+ */
+void ccl_workspace_release_all(void);
+
+CCL_END_DECLS
+
+#endif
@@ -45,3 +45,4 @@ from . import halos
 from . import nl_pt
 
 from .cosmology import *
+from .precision import *
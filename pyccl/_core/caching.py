@@ -1,6 +1,11 @@
-__all__ = ("hash_", "Caching", "cache", "CacheInfo", "CachedObject",)
-
-import sys
+__all__ = ("hash_", "Caching", "cache", "CacheInfo", "CachedObject",
+           "DiskCache",)
+
+import os
+import pickle
+import hashlib
+import tempfile
+import warnings
 import functools
 from collections import OrderedDict
 from inspect import signature
@@ -8,6 +13,12 @@ from _thread import RLock
 
 import numpy as np
 
+try:
+    from importlib.metadata import version as _version
+    _CCL_VERSION = _version("pyccl")
+except Exception:
+    _CCL_VERSION = "unknown"
+
 
 def _to_hashable(obj):
     """Make unhashable objects hashable in a consistent manner."""
@@ -46,10 +57,70 @@ def _to_hashable(obj):
     raise TypeError(f"Hashing for {type(obj)} not implemented.")
 
 
+def _hash_update(hasher, obj):
+    """Feed ``obj`` into ``hasher``, mirroring the traversal of
+    :func:`_to_hashable`. Every item is prefixed with its type so that,
+    e.g., ``1``, ``1.0`` and ``'1'`` produce different digests.
+    """
+    hasher.update(type(obj).__name__.encode())
+
+    if isinstance(obj, (int, float, str)):
+        hasher.update(repr(obj).encode())
+
+    elif hasattr(obj, "__iter__"):
+        if isinstance(obj, np.ndarray):
+            # Numpy arrays: Stream the data buffer, without copying it
+            # unless the array is not contiguous.
+            hasher.update(f"{obj.dtype.str}{obj.shape}".encode())
+            if obj.dtype.hasobject:
+                for item in obj.flat:
+                    _hash_update(hasher, item)
+            else:
+                hasher.update(np.ascontiguousarray(obj))
+
+        elif isinstance(obj, dict):
+            # Sort unordered dictionaries for hash consistency.
+            items = obj.items()
+            if not isinstance(obj, OrderedDict):
+                items = sorted(items, key=lambda item: repr(item[0]))
+            hasher.update(f"{len(obj)}".encode())
+            for key, value in items:
+                _hash_update(hasher, key)
+                _hash_update(hasher, value)
+
+        elif isinstance(obj, (set, frozenset)):
+            # Set ordering of strings changes between processes.
+            hasher.update(f"{len(obj)}".encode())
+            for item in sorted(obj, key=repr):
+                _hash_update(hasher, item)
+
+        elif isinstance(obj, (bytes, bytearray)):
+            hasher.update(obj)
+
+        else:
+            items = list(obj)
+            hasher.update(f"{len(items)}".encode())
+            for item in items:
+                _hash_update(hasher, item)
+
+    else:
+        # Hashables: Use the representation of the object.
+        hasher.update(repr(obj).encode())
+
+    # Close the item so that nested containers are unambiguous.
+    hasher.update(b";")
+
+
 def hash_(obj):
-    """Generic hash method, which changes between processes."""
-    digest = hash(repr(_to_hashable(obj))) + sys.maxsize + 1
-    return digest
+    """Generic hash method, which is stable between processes.
+
+    The object is streamed through a fast non-cryptographic digest
+    (BLAKE2b with an 8-byte output), so large arrays are hashed directly
+    from their data buffers without building intermediate strings.
+    """
+    hasher = hashlib.blake2b(digest_size=8)
+    _hash_update(hasher, obj)
+    return int.from_bytes(hasher.digest(), "little")
 
 
 class _CachingMeta(type):
@@ -110,6 +181,7 @@ class Caching(metaclass=_CachingMeta):
     _maxsize = _default_maxsize   # user-defined maxsize
     _policy = _default_policy     # user-defined policy
     _cached_functions: list = []
+    _disk_cache = None            # `DiskCache` instance, if enabled
 
     @classmethod
     def _get_key(cls, func, *args, **kwargs):
@@ -144,15 +216,24 @@ class Caching(metaclass=_CachingMeta):
         dic.popitem(last=False)
 
     @classmethod
-    def _decorator(cls, func, maxsize, policy):
+    def _get_disk_key(cls, func, key):
+        """Disk keys must also identify the function, as all functions
+        share the same storage directory.
+        """
+        return hex(hash_((func.__module__, func.__qualname__, key)))
+
+    @classmethod
+    def _decorator(cls, func, maxsize, policy, disk):
         # assign caching attributes to decorated function
-        func.cache_info = CacheInfo(func, maxsize=maxsize, policy=policy)
+        func.cache_info = CacheInfo(func, maxsize=maxsize, policy=policy,
+                                    disk=disk)
         func.clear_cache = func.cache_info._clear_cache
         cls._cached_functions.append(func)
 
         @functools.wraps(func)
         def wrapper(*args, **kwargs):
-            if not cls._enabled:
+            disk = cls._disk_cache if func.cache_info.disk else None
+            if not (cls._enabled or disk):
                 return func(*args, **kwargs)
 
             key = cls._get_key(func, *args, **kwargs)
@@ -161,12 +242,27 @@ class Caching(metaclass=_CachingMeta):
             maxsize = func.cache_info.maxsize
             policy = func.cache_info.policy
 
-            with RLock():
-                if key in caches:
-                    # output has been cached; update stats and return it
-                    out = cls._get(caches, key, policy)
-                    func.cache_info.hits += 1
-                    return out.item
+            if cls._enabled:
+                with RLock():
+                    if key in caches:
+                        # output has been cached; update stats and return it
+                        out = cls._get(caches, key, policy)
+                        func.cache_info.hits += 1
+                        return out.item
+
+            if disk is not None:
+                disk_key = cls._get_disk_key(func, key)
+                item = disk.load(disk_key)
+                if item is not None:
+                    func.cache_info.disk_hits += 1
+                else:
+                    item = func(*args, **kwargs)
+                    disk.save(disk_key, item)
+            else:
+                item = func(*args, **kwargs)
+
+            if not cls._enabled:
+                return item
 
             with RLock():
                 while len(caches) >= maxsize:
@@ -175,7 +271,7 @@ class Caching(metaclass=_CachingMeta):
                     cls._pop(caches, policy)
 
             # cache new entry and update stats
-            out = CachedObject(func(*args, **kwargs))
+            out = CachedObject(item)
             caches[key] = out
             func.cache_info.misses += 1
             return out.item
@@ -183,7 +279,8 @@ class Caching(metaclass=_CachingMeta):
         return wrapper
 
     @classmethod
-    def cache(cls, func=None, *, maxsize=_maxsize, policy=_policy):
+    def cache(cls, func=None, *, maxsize=_maxsize, policy=_policy,
+              disk=False):
         """Cache the output of the decorated function, using the input
         arguments as a proxy to build a hash key.
 
@@ -198,6 +295,10 @@ class Caching(metaclass=_CachingMeta):
                 'fifo': first-in-first-out,\n
                 'lru': least-recently-used,\n
                 'lfu': least-frequently-used.
+            disk (``bool``):
+                If ``True``, the output is also stored in the on-disk cache,
+                when enabled via :meth:`Caching.enable_disk_cache`. The
+                output must be picklable.
         """
         if maxsize < 0:
             raise ValueError(
@@ -209,9 +310,10 @@ class Caching(metaclass=_CachingMeta):
         if func is None:
             # `@cache` with parentheses
             return functools.partial(
-                cls._decorator, maxsize=maxsize, policy=policy)
+                cls._decorator, maxsize=maxsize, policy=policy, disk=disk)
         # `@cache()` without parentheses
-        return cls._decorator(func, maxsize=maxsize, policy=policy)
+        return cls._decorator(func, maxsize=maxsize, policy=policy,
+                              disk=disk)
 
     @classmethod
     def enable(cls):
@@ -230,6 +332,27 @@ class Caching(metaclass=_CachingMeta):
     def clear_cache(cls):
         [func.clear_cache() for func in cls._cached_functions]
 
+    @classmethod
+    def enable_disk_cache(cls, path=None):
+        """Store expensive results (e.g. linear power spectra from Boltzmann
+        codes) on disk, so that they can be reused across processes.
+
+        Arguments:
+            path (``str``):
+                Cache directory. Defaults to ``$PYCCL_CACHE_DIR`` if set,
+                or to ``pyccl`` in the user cache directory otherwise.
+        """
+        cls._disk_cache = DiskCache(path)
+
+    @classmethod
+    def disable_disk_cache(cls):
+        cls._disk_cache = None
+
+    @classmethod
+    def get_disk_cache(cls):
+        """Return the active :class:`DiskCache`, or ``None``."""
+        return cls._disk_cache
+
 
 cache = Caching.cache
 
@@ -252,16 +375,20 @@ class CacheInfo:
               - ``misses``: number of times the function has computed
               something.
               - ``current_size``: current size of the cache dictionary.
+              - ``disk_hits``: number of times the output was read from
+              the on-disk cache.
     """
 
-    def __init__(self, func, maxsize=Caching.maxsize, policy=Caching.policy):
+    def __init__(self, func, maxsize=Caching.maxsize, policy=Caching.policy,
+                 disk=False):
         # we store the signature of the function on import
         # as it is the most expensive operation (~30x slower)
         self._signature = signature(func)
         self._caches = OrderedDict()
         self.maxsize = maxsize
         self.policy = policy
-        self.hits = self.misses = 0
+        self.disk = disk
+        self.hits = self.misses = self.disk_hits = 0
 
     @property
     def current_size(self):
@@ -277,7 +404,7 @@ class CacheInfo:
 
     def _clear_cache(self):
         self._caches = OrderedDict()
-        self.hits = self.misses = 0
+        self.hits = self.misses = self.disk_hits = 0
 
 
 class CachedObject:
@@ -301,3 +428,68 @@ class CachedObject:
 
     def reset(self):
         self.counter = 0
+
+
+class DiskCache:
+    """Persistent on-disk store for expensive results.
+
+    Each entry is pickled to its own file, named after its key and the
+    version of CCL, so entries written by other versions are never read.
+    Keys are built with :func:`hash_`, which is stable across processes,
+    so the entries can be shared between runs.
+
+    Parameters:
+        path (``str``):
+            Cache directory. Created if it does not exist.
+    """
+
+    def __init__(self, path=None):
+        if path is None:
+            path = os.environ.get("PYCCL_CACHE_DIR")
+        if path is None:
+            root = os.environ.get("XDG_CACHE_HOME",
+                                  os.path.join("~", ".cache"))
+            path = os.path.join(root, "pyccl")
+        self.path = os.path.abspath(os.path.expanduser(path))
+        os.makedirs(self.path, exist_ok=True)
+
+    def __repr__(self):
+        return f"{self.__class__.__name__}(path={self.path!r})"
+
+    def _fname(self, key):
+        name = hex(hash_((_CCL_VERSION, key)))
+        return os.path.join(self.path, f"{name}.pkl")
+
+    def __contains__(self, key):
+        return os.path.isfile(self._fname(key))
+
+    def load(self, key):
+        """Return the object stored under ``key``, or ``None`` if it is
+        missing or unreadable.
+        """
+        try:
+            with open(self._fname(key), "rb") as f:
+                return pickle.load(f)
+        except Exception:
+            # Missing, truncated or stale entry.
+            return None
+
+    def save(self, key, obj):
+        """Store ``obj`` under ``key``. The file is written atomically, so
+        concurrent processes never read a partial entry.
+        """
+        fd, tmp = tempfile.mkstemp(dir=self.path, suffix=".tmp")
+        try:
+            with os.fdopen(fd, "wb") as f:
+                pickle.dump(obj, f, protocol=pickle.HIGHEST_PROTOCOL)
+            os.replace(tmp, self._fname(key))
+        except Exception as err:
+            os.remove(tmp)
+            warnings.warn(f"Could not store {type(obj).__name__} in the "
+                          f"disk cache: {err}", RuntimeWarning)
+
+    def clear(self):
+        """Remove all the entries from the cache directory."""
+        for fname in os.listdir(self.path):
+            if fname.endswith(".pkl"):
+                os.remove(os.path.join(self.path, fname))
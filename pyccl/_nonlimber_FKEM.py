@@ -72,16 +72,8 @@ def _nonlimber_FKEM(
     psp_lin = cosmo.parse_pk2d(p_of_k_a_lin, is_linear=True)
     psp_nonlin = cosmo.parse_pk2d(p_of_k_a, is_linear=False)
 
-    t1, status = lib.cl_tracer_collection_t_new(status)
-    check(status)
-    t2, status = lib.cl_tracer_collection_t_new(status)
-    check(status)
-    for t in clt1._trc:
-        status = lib.add_cl_tracer_to_collection(t1, t, status)
-        check(status)
-    for t in clt2._trc:
-        status = lib.add_cl_tracer_to_collection(t2, t, status)
-        check(status)
+    t1 = clt1._get_collection()
+    t2 = clt2._get_collection()
     if isinstance(p_of_k_a_lin, ccl.Pk2D):
         pk = p_of_k_a_lin
     else:
@@ -12,7 +12,7 @@ CCL defines seven species types:
 These strings define the `species` inputs to the functions below.
 """ # noqa
 __all__ = (
-    "Species", "compute_distances",
+    "Species", "compute_distances", "compute_halo_background",
     "h_over_h0", "comoving_radial_distance", "scale_factor_of_chi",
     "comoving_angular_distance", "angular_diameter_distance",
     "luminosity_distance", "distance_modulus",
@@ -77,6 +77,16 @@ def compute_distances(cosmo):
     cosmo.data.age0 = cosmo.data.lookback(0, extrapolate=True)[()]
 
 
+def compute_halo_background(cosmo):
+    """Compute the splines of :math:`\\Omega_M(a)` and of the virial
+    overdensity used by the halo model."""
+    if cosmo.has_halo_background:
+        return
+    status = 0
+    status = lib.cosmology_compute_halo_background(cosmo.cosmo, status)
+    check(status, cosmo)
+
+
 def h_over_h0(cosmo, a):
     """Ratio of Hubble constant at `a` over Hubble constant today.
 
@@ -7,7 +7,7 @@ try:
 except ModuleNotFoundError:
     pass  # prevent nans from isitgr
 
-from . import CCLError, Pk2D, check, lib, sigma8
+from . import CCLError, Pk2D, UnlockInstance, check, lib, sigma8
 
 
 def get_camb_pk_lin(cosmo, *, nonlin=False):
@@ -473,13 +473,15 @@ def get_class_pk_lin(cosmo):
         nk = int(np.sum(msk))
         lk_arr = lk_arr[msk]
 
-        # now do interp by hand
-        ln_p_k_and_z = np.zeros((na, nk), dtype=np.float64)
-        for aind in range(na):
-            z = max(1.0 / a_arr[aind] - 1, 1e-10)
-            for kind in range(nk):
-                ln_p_k_and_z[aind, kind] = np.log(
-                    model.pk_lin(np.exp(lk_arr[kind]), z))
+        # Extract the whole (a, k) grid in one call, with k running
+        # fastest. Older versions of classy lack the array interface.
+        z_arr = np.maximum(1.0 / a_arr - 1, 1e-10)
+        k_arr = np.exp(lk_arr)
+        if hasattr(model, "get_pk_array"):
+            pk_arr = model.get_pk_array(k_arr, z_arr, nk, na, 0)
+        else:
+            pk_arr = np.array([model.pk_lin(k, z)
+                               for z in z_arr for k in k_arr])
     finally:
         if model is not None:
             model.struct_cleanup()
@@ -487,13 +489,12 @@ def get_class_pk_lin(cosmo):
 
     params["P_k_max_1/Mpc"] = cosmo.cosmo.spline_params.K_MAX_SPLINE
 
-    # make the Pk2D object
-    pk_lin = Pk2D(
-        a_arr=a_arr,
-        lk_arr=lk_arr,
-        pk_arr=ln_p_k_and_z,
-        is_logp=True,
-        extrap_order_lok=1,
-        extrap_order_hik=2)
+    # make the Pk2D object, taking the logarithm in C
+    pk_lin = Pk2D.__new__(Pk2D)
+    status = 0
+    with UnlockInstance(pk_lin):
+        pk_lin.psp, status = lib.set_pk2d_new_from_power(
+            lk_arr, a_arr, pk_arr, 1, 2, status)
+    check(status, cosmo=cosmo)
 
     return pk_lin
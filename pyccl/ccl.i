@@ -55,6 +55,9 @@ from .errors import CCLError
 %include "ccl_f1d.i"
 %include "ccl_fftlog.i"
 %include "ccl_utils.i"
+%include "ccl_memory.i"
+%include "ccl_workspace.i"
+%include "ccl_halo_profiles.i"
 
 /* list header files not yet having a .i file here */
 %include "../include/ccl_config.h"
@@ -78,6 +78,16 @@ void rho_x_vec(ccl_cosmology * cosmo, int label, int is_comoving,
       output[i] = ccl_rho_x(cosmo, a[i], label, is_comoving, status);
     }
 }
+
+void Delta_vir_vec(ccl_cosmology * cosmo, int label, double* a, int na,
+                   int nout, double* output, int *status) {
+    ccl_Delta_virs(cosmo, na, a, label, output, status);
+}
+
+void delta_c_vec(ccl_cosmology * cosmo, int kind, double sigma8,
+                 double* a, int na, int nout, double* output, int *status) {
+    ccl_delta_cs(cosmo, na, a, kind, sigma8, output, status);
+}
 %}
 
 /* Now we change the directive for `chi` instead of `a`. */
@@ -128,4 +138,16 @@ void cosmology_growth_from_input(ccl_cosmology * cosmo,
     ccl_cosmology_growth_from_input(cosmo, na, a, growth, fgrowth, status);
 }
 
+void cosmology_background_from_input(ccl_cosmology * cosmo,
+        double* a, int na, double* chi, int nchi, double* hoh0, int nhoh0,
+        double* growth, int ngrowth, double* fgrowth, int nfgrowth,
+        int * status) {
+    if ((nchi != na) || (nhoh0 != na) || (ngrowth != na) || (nfgrowth != na)) {
+        *status = CCL_ERROR_INCONSISTENT;
+        return;
+    }
+    ccl_cosmology_background_from_input(cosmo, na, a, chi, hoh0,
+                                        growth, fgrowth, status);
+}
+
 %}
@@ -9,6 +9,11 @@
 // Enable vectorised arguments for arrays
 %apply (double* IN_ARRAY1, int DIM1) {(double* ell, int nell)};
 %apply (int DIM1, double* ARGOUT_ARRAY1) {(int nout, double* output)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* theta, int ntheta)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* ell_sample, int nell_sample)};
+%apply (int* IN_ARRAY1, int DIM1) {(int* bpw_start, int nstart)};
+%apply (int* IN_ARRAY1, int DIM1) {(int* ell_nz, int nell_nz)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* w_nz, int nw_nz)};
 
 
 %feature("pythonprepend") angular_cl_vec %{
@@ -112,3 +117,142 @@ void angular_cl_vec_limber(ccl_cosmology * cosmo,
 }
 
 %}
+
+
+%feature("pythonprepend") angular_cl_vec_limber_extended %{
+    if numpy.shape(ell) != (nout,):
+        raise CCLError("Input shape for `ell` must match `(nout,)`!")
+%}
+
+%inline %{
+
+void angular_cl_vec_limber_extended(ccl_cosmology * cosmo,
+                                    ccl_cl_tracer_collection_t *clt1,
+                                    ccl_cl_tracer_collection_t *clt2,
+                                    ccl_f2d_t *pspec,
+                                    double* ell, int nell,
+                                    int integration_type,
+                                    int nout, double* output,
+                                    int *status) {
+  ccl_angular_cls_limber_extended(cosmo, clt1, clt2, pspec, nell, ell,
+                                  output, integration_type, status);
+}
+
+%}
+
+
+%feature("pythonprepend") angular_cl_derivs_vec_limber %{
+    if numpy.size(ell)*derivs.n_par != nout:
+        raise CCLError("Output size must match `(n_par*nell,)`!")
+%}
+
+%inline %{
+
+void angular_cl_derivs_vec_limber(ccl_cosmology * cosmo,
+                                  ccl_cl_tracer_collection_t *clt1,
+                                  ccl_cl_tracer_collection_t *clt2,
+                                  ccl_f2d_t *pspec,
+                                  ccl_cl_derivs_t *derivs,
+                                  double* ell, int nell,
+                                  int nout, double* output,
+                                  int *status) {
+  ccl_angular_cls_limber_derivs(cosmo, clt1, clt2, pspec, derivs,
+                                nell, ell, output, status);
+}
+
+%}
+
+
+%feature("pythonprepend") angular_cl_batch_vec_limber %{
+    if numpy.size(ell)*batch.n_cl != nout:
+        raise CCLError("Output size must match `(n_cl*nell,)`!")
+%}
+
+%inline %{
+
+void angular_cl_batch_vec_limber(ccl_cl_batch_t *batch,
+                                 double* ell, int nell,
+                                 int integration_type,
+                                 int nout, double* output,
+                                 int *status) {
+  ccl_angular_cls_limber_batch(batch, nell, ell, output,
+                               integration_type, status);
+}
+
+%}
+
+
+%feature("pythonprepend") bandpowers_new %{
+    if (len(ell_nz) != len(w_nz)) or (len(ell_nz) != bpw_start[-1]):
+        raise CCLError("Input shapes for `ell_nz` and `w_nz` must match "
+                       "`(bpw_start[-1],)`!")
+%}
+
+%inline %{
+
+ccl_bandpowers_t *bandpowers_new(int* bpw_start, int nstart,
+                                 int* ell_nz, int nell_nz,
+                                 double* w_nz, int nw_nz,
+                                 int n_sample, int *status) {
+  return ccl_bandpowers_t_new(nstart-1, bpw_start, ell_nz, w_nz,
+                              n_sample, status);
+}
+
+%}
+
+
+%feature("pythonprepend") angular_cl_vec_limber_bandpowers %{
+    if bpw.n_bpw != nout:
+        raise CCLError("Output size must match `(n_bpw,)`!")
+%}
+
+%inline %{
+
+void angular_cl_vec_limber_bandpowers(ccl_cosmology * cosmo,
+                                      ccl_cl_tracer_collection_t *clt1,
+                                      ccl_cl_tracer_collection_t *clt2,
+                                      ccl_f2d_t *pspec,
+                                      ccl_bandpowers_t *bpw,
+                                      int integration_type,
+                                      int nout, double* output,
+                                      int *status) {
+  ccl_angular_cls_limber_bandpowers(cosmo, clt1, clt2, pspec, bpw, output,
+                                    integration_type, status);
+}
+
+%}
+
+
+%inline %{
+
+int data_vector_size(ccl_data_vector_t *dv,
+                     double* ell, int nell,
+                     double* theta, int ntheta) {
+  return ccl_data_vector_t_size(dv, nell, ell, ntheta, theta);
+}
+
+%}
+
+
+%feature("pythonprepend") angular_data_vector_vec_limber %{
+    if data_vector_size(dv, ell, theta) != nout:
+        raise CCLError("Output size must match the size of the data vector!")
+%}
+
+%inline %{
+
+void angular_data_vector_vec_limber(ccl_cosmology * cosmo,
+                                    ccl_f2d_t *pspec,
+                                    ccl_data_vector_t *dv,
+                                    double* ell, int nell,
+                                    double* theta, int ntheta,
+                                    double* ell_sample, int nell_sample,
+                                    int integration_type,
+                                    int nout, double* output,
+                                    int *status) {
+  ccl_angular_data_vector_limber(cosmo, pspec, dv, nell, ell, ntheta, theta,
+                                 nell_sample, ell_sample, output,
+                                 integration_type, status);
+}
+
+%}
@@ -13,7 +13,10 @@
     (double* theta, int nt),
     (double* r, int nr),
     (double* s, int ns),
-    (double* sig, int nsig)}
+    (double* sig, int nsig),
+    (double* a_arr, int na),
+    (double* beta_arr, int nbeta),
+    (double* rp, int nrp)}
 %apply (int DIM1, double* ARGOUT_ARRAY1) {
     (int nout, double* output),
     (int nxi, double* xi),
@@ -52,6 +55,14 @@
         raise CCLError("Input shape for `sig` must match `(nxis,)`!")
 %}
 
+%feature("pythonprepend") correlation_projected_vec %{
+    if (len(beta_arr) > 0) and (numpy.shape(beta_arr) != numpy.shape(a_arr)):
+        raise CCLError("Input shape for `beta_arr` must match `a_arr`!")
+
+    if nout != len(a_arr) * len(rp):
+        raise CCLError("Input shape for `nout` must match `len(a_arr)*len(rp)`!")
+%}
+
 %inline %{
 
 void correlation_vec(ccl_cosmology *cosmo, double* larr, int nlarr,
@@ -97,4 +108,13 @@ void correlation_pi_sigma_vec(ccl_cosmology *cosmo,ccl_f2d_t *psp,
                               int *status){
   ccl_correlation_pi_sigma(cosmo,psp,a,beta,pie,nsig,sig,xis,use_spline,status);
 }
+
+void correlation_projected_vec(ccl_cosmology *cosmo,ccl_f2d_t *psp,
+                               double *a_arr,int na,
+                               double *beta_arr,int nbeta,
+                               double pi_max,double *rp,int nrp,
+                               int nout,double *output,int *status){
+  ccl_correlation_projected(cosmo,psp,na,a_arr,nbeta > 0 ? beta_arr : NULL,
+                            pi_max,nrp,rp,output,status);
+}
 %}
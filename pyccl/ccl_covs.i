@@ -12,6 +12,12 @@
 %apply (double* IN_ARRAY1, int DIM1) {(double* s2b, int ns2b)};
 %apply (double* IN_ARRAY1, int DIM1) {(double* a, int na)};
 %apply (double* IN_ARRAY1, int DIM1) {(double* R, int nR)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* ell, int nell)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* dell, int ndell)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* cl, int ncl)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* noise, int nnoise)};
+%apply (int* IN_ARRAY1, int DIM1) {(int* pair_i, int npi)};
+%apply (int* IN_ARRAY1, int DIM1) {(int* pair_j, int npj)};
 %apply (int DIM1, double* ARGOUT_ARRAY1) {(int nout, double* output)};
 
 %feature("pythonprepend") sigma2b_vec %{
@@ -94,3 +100,39 @@ void angular_cov_ssc_vec(ccl_cosmology * cosmo,
 }
 
 %}
+
+%feature("pythonprepend") angular_cov_gaussian_vec %{
+    if len(cl) != n_tr*n_tr*len(ell):
+        raise CCLError("Input shape for `cl` must match `(n_tr, n_tr, nell)`!")
+    if len(noise) not in [0, len(cl)]:
+        raise CCLError("Input shape for `noise` must match that of `cl`!")
+    if len(dell) not in [0, len(ell)]:
+        raise CCLError("Input shape for `dell` must match that of `ell`!")
+    if len(pair_i) != len(pair_j):
+        raise CCLError("Input shapes for `pair_i` and `pair_j` must match!")
+    if len(pair_i)*len(pair_i)*len(ell) != nout:
+        raise CCLError("Input shape for `pair_i` and `ell` must match `(nout,)`!")
+%}
+
+%inline %{
+
+void angular_cov_gaussian_vec(int n_tr,
+                              double* ell, int nell,
+                              double* dell, int ndell,
+                              double* cl, int ncl,
+                              double* noise, int nnoise,
+                              double fsky,
+                              int* pair_i, int npi,
+                              int* pair_j, int npj,
+                              int nout, double* output,
+                              int *status)
+{
+  // Empty arrays stand for unit bin widths and no noise
+  ccl_angular_cl_covariance_gaussian(n_tr, nell, ell,
+                                     ndell > 0 ? dell : NULL,
+                                     cl, nnoise > 0 ? noise : NULL,
+                                     fsky, npi, pair_i, pair_j,
+                                     output, status);
+}
+
+%}
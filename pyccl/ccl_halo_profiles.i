@@ -0,0 +1,100 @@
+%module ccl_halo_profiles
+
+%{
+/* put additional #include here */
+%}
+
+%include "../include/ccl_halo_profiles.h"
+
+// Enable vectorised arguments for arrays
+%apply (double* IN_ARRAY1, int DIM1) {(double* q_arr, int nq)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* alpha_arr, int nalpha)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* x_arr, int nx)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* M_arr, int nM)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* rs_arr, int nrs)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* c_arr, int nc)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* r_arr, int nr)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* w_arr, int nw)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* u1_arr, int nu1)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* u2_arr, int nu2)};
+%apply (int DIM1, double* ARGOUT_ARRAY1) {(int nout, double* output)};
+
+%feature("pythonprepend") gnfw_fourier_table_vec %{
+    if numpy.shape(q_arr) != (nout,):
+        raise CCLError("Input shape for `q_arr` must match `(nout,)`!")
+%}
+
+%feature("pythonprepend") einasto_tables_vec %{
+    if nout != len(alpha_arr) * (len(q_arr) + len(x_arr)):
+        raise CCLError("Output size must match "
+                       "`len(alpha_arr) * (len(q_arr) + len(x_arr))`!")
+%}
+
+%feature("pythonprepend") hernquist_profile_vec %{
+    if (numpy.shape(rs_arr) != numpy.shape(M_arr) or
+            numpy.shape(c_arr) != numpy.shape(M_arr)):
+        raise CCLError("Input shapes for `M_arr`, `rs_arr` and `c_arr` "
+                       "must match!")
+    if nout != len(M_arr) * len(r_arr):
+        raise CCLError("Output size must match "
+                       "`len(M_arr) * len(r_arr)`!")
+%}
+
+%feature("pythonprepend") halomod_mass_outer_vec %{
+    if len(u1_arr) % len(w_arr) or len(u2_arr) % len(w_arr):
+        raise CCLError("Input sizes for `u1_arr` and `u2_arr` must be "
+                       "multiples of `len(w_arr)`!")
+    if nout * len(w_arr)**2 != len(u1_arr) * len(u2_arr):
+        raise CCLError("Output size must match "
+                       "`len(u1_arr) * len(u2_arr) / len(w_arr)**2`!")
+%}
+
+%inline %{
+
+void gnfw_fourier_table_vec(double alpha, double beta, double gamma,
+                            double c500, double x_out,
+                            double padding_lo, double padding_hi,
+                            double n_per_decade,
+                            double* q_arr, int nq,
+                            int nout, double* output,
+                            int *status) {
+  ccl_gnfw_fourier_table(alpha, beta, gamma, c500, x_out,
+                         padding_lo, padding_hi, n_per_decade,
+                         nq, q_arr, output, status);
+}
+
+// Fourier-space templates for all alphas followed by the projected ones
+void einasto_tables_vec(double* alpha_arr, int nalpha,
+                        double padding_lo, double padding_hi,
+                        double n_per_decade,
+                        double* q_arr, int nq,
+                        double* x_arr, int nx,
+                        int nout, double* output,
+                        int *status) {
+  ccl_einasto_tables(nalpha, alpha_arr, padding_lo, padding_hi,
+                     n_per_decade, nq, q_arr, output,
+                     nx, x_arr, output+nalpha*nq, status);
+}
+
+void hernquist_profile_vec(int kind, int truncated,
+                           double* M_arr, int nM,
+                           double* rs_arr, int nrs,
+                           double* c_arr, int nc,
+                           double* r_arr, int nr,
+                           int nout, double* output,
+                           int *status) {
+  ccl_hernquist_profile(kind, truncated, nM, M_arr, rs_arr, c_arr,
+                        nr, r_arr, output, status);
+}
+
+// Profiles are passed as flattened (N_k, N_M) arrays
+void halomod_mass_outer_vec(double* w_arr, int nw,
+                            double* u1_arr, int nu1,
+                            double* u2_arr, int nu2,
+                            int nout, double* output,
+                            int *status) {
+  ccl_halomod_mass_outer(nw, w_arr, nu1/nw, u1_arr, nu2/nw, u2_arr,
+                         output, status);
+}
+
+%}
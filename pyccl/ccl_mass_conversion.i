@@ -8,13 +8,23 @@
 
 // Enable vectorised arguments for arrays
 %apply (double* IN_ARRAY1, int DIM1) {(double* c_in, int nc)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* d_factor_arr, int na)};
+%apply (double* IN_ARRAY1, int DIM1) {(double* lM_arr, int nM)};
 %apply (int DIM1, double* ARGOUT_ARRAY1) {(int nout, double* output)};
 
-%feature("pythonprepend") %{
+%feature("pythonprepend") convert_concentration_vec %{
     if numpy.shape(c_in) != (nout,):
         raise CCLError("Input shape for `c` must match `(nout,)`!")
 %}
 
+%feature("pythonprepend") mass_translation_table_vec %{
+    if numpy.shape(c_in) != (len(d_factor_arr) * len(lM_arr),):
+        raise CCLError("Input shape for `c_in` must match "
+                       "`(len(d_factor_arr) * len(lM_arr),)`!")
+    if nout != 2 * len(c_in):
+        raise CCLError("Output size must match `2 * len(c_in)`!")
+%}
+
 %inline %{
 
   void convert_concentration_vec(ccl_cosmology *cosmo,
@@ -26,6 +36,17 @@
   ccl_convert_concentration(cosmo, delta_old, nc, c_in,
 			    delta_new, output,status);
 }
+
+// Translated log-masses followed by the Jacobians
+void mass_translation_table_vec(ccl_cosmology *cosmo,
+                                double* d_factor_arr, int na,
+                                double* lM_arr, int nM,
+                                double* c_in, int nc,
+                                int nout, double* output,
+                                int *status) {
+  ccl_mass_translation_table(cosmo, na, d_factor_arr, nM, lM_arr, c_in,
+                             output, output+nc, status);
+}
 %}
 
 /* The directive gets carried between files, so we reset it at the end. */
@@ -0,0 +1,7 @@
+%module ccl_memory
+
+%{
+/* put additional #include here */
+%}
+
+%include "../include/ccl_memory.h"
@@ -27,6 +27,59 @@ ccl_f2d_t *set_pk2d_new_from_arrays(double* lkarr,int nk,
   return psp;
 }
 
+ccl_f2d_t *set_pk2d_new_from_power(double* lkarr,int nk,
+				   double* aarr,int na,
+				   double* pkarr,int npk,
+				   int order_lok,int order_hik,
+				   int *status)
+{
+  if(npk != na*nk) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return NULL;
+  }
+  return ccl_f2d_t_new_from_pk(na,aarr,nk,lkarr,pkarr,
+			       order_lok,order_hik,status);
+}
+
+ccl_f2d_t *set_pk2d_new_from_input(double* lkarr,int nk,
+				   double* aarr,int na,
+				   double* pkarr,int npk,
+				   int order_lok,int order_hik,
+				   int *status)
+{
+  int ii;
+  int is_logp = 1;
+  double *lpkarr;
+  ccl_f2d_t *psp;
+
+  if(npk != na*nk) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return NULL;
+  }
+
+  lpkarr = malloc(npk*sizeof(double));
+  if(lpkarr == NULL) {
+    *status = CCL_ERROR_MEMORY;
+    return NULL;
+  }
+
+  // Spline in log-space if the P(k) is positive-definite. The logarithm
+  // is taken in the same pass that checks the sign.
+  for(ii=0;ii<npk;ii++) {
+    if(!(pkarr[ii] > 0)) {
+      is_logp = 0;
+      break;
+    }
+    lpkarr[ii] = log(pkarr[ii]);
+  }
+
+  psp = set_pk2d_new_from_arrays(lkarr,nk,aarr,na,
+                                 is_logp ? lpkarr : pkarr,npk,
+                                 order_lok,order_hik,is_logp,status);
+  free(lpkarr);
+  return psp;
+}
+
 void get_pk_spline_a(ccl_cosmology *cosmo,int ndout,double* doutput,int *status)
 {
   ccl_get_pk_spline_a_array(cosmo,ndout,doutput,status);
@@ -242,3 +242,19 @@ ccl_cl_tracer_t *cl_tracer_t_new_wrapper(ccl_cosmology *cosmo,
   return t;
 }
 %}
+
+%feature("pythonprepend") cl_tracer_t_new_with_kernel_wrapper %{
+    if numpy.shape(chi_s) != numpy.shape(wchi_s):
+        raise CCLError("Input shape for `chi_s` must match `wchi_s`!")
+%}
+
+%inline %{
+ccl_cl_tracer_t *cl_tracer_t_new_with_kernel_wrapper(ccl_cosmology *cosmo,
+						     ccl_cl_tracer_t *tr,
+						     double *chi_s,int nchi,
+						     double *wchi_s,int nwchi,
+						     int *status)
+{
+  return ccl_cl_tracer_t_new_with_kernel(cosmo,tr,nchi,chi_s,wchi_s,status);
+}
+%}
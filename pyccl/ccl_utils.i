@@ -181,3 +181,19 @@ void get_array(double *arr,
 }
 
 %}
+
+
+%feature("pythonprepend") spherical_bessel_array %{
+    if nout != (l_max+1) * numpy.size(x_in):
+        raise CCLError("Output size must match `(l_max+1)*x_in.size`")
+%}
+
+%inline %{
+
+void spherical_bessel_array(int l_max, double *x_in, int n_in_x,
+                            int nout, double *output, int *status)
+{
+  ccl_j_bessel_array(l_max, n_in_x, x_in, output, status);
+}
+
+%}
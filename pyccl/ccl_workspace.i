@@ -0,0 +1,7 @@
+%module ccl_workspace
+
+%{
+/* put additional #include here */
+%}
+
+%include "../include/ccl_workspace.h"
@@ -1,9 +1,11 @@
-__all__ = ("angular_cl",)
+__all__ = ("angular_cl", "angular_cl_batch", "angular_cl_bandpowers",
+           "angular_data_vector", "angular_cl_derivatives",
+           "angular_cl_gradient",)
 
 import numpy as np
 
 from . import DEFAULT_POWER_SPECTRUM, CCLWarning, check, lib, warnings
-from .pyutils import integ_types
+from .pyutils import _get_spline1d_arrays, integ_types
 from ._nonlimber_FKEM import _nonlimber_FKEM
 
 
@@ -17,6 +19,7 @@ def angular_cl(
     l_limber=-1,
     limber_max_error=0.01,
     limber_integration_method="qag_quad",
+    limber_order=1,
     non_limber_integration_method="FKEM",
     fkem_chi_min=None,
     fkem_Nchi=None,
@@ -45,6 +48,16 @@ def angular_cl(
             for the Limber integrals. Possibilities: 'qag_quad' (GSL's `qag`
             method backed up by `quad` when it fails) and 'spline' (the
             integrand is splined and then integrated numerically).
+        limber_order (int) : order of the Limber approximation. If 1, the
+            standard (leading-order) approximation is used. If 2, the
+            second-order correction of the extended Limber approximation
+            (`LoVerde & Afshordi 2008 <https://arxiv.org/abs/0809.5112>`_)
+            is included, which improves the accuracy on large scales at
+            roughly five times the cost. Derivatives of the radial kernels,
+            transfer functions and power spectrum are computed with finite
+            differences in :math:`\chi`. Contributions involving
+            derivatives of the Bessel functions (e.g. redshift-space
+            distortions) are always computed at leading order.
         non_limber_integration_method (string) : integration method to be used
             for the non-Limber integrals. Currently the only method implemented
             is ``'FKEM'`` (see the `N5K paper <https://arxiv.org/abs/2212.04291>`_
@@ -89,6 +102,8 @@ def angular_cl(
             "Limber integration method %s not supported"
             % limber_integration_method
         )
+    if limber_order not in [1, 2]:
+        raise ValueError("limber_order must be 1 or 2")
     if non_limber_integration_method not in ["FKEM"]:
         raise ValueError(
             "Non-Limber integration method %s not supported"
@@ -108,14 +123,10 @@ def angular_cl(
 
     psp = cosmo.parse_pk2d(p_of_k_a, is_linear=False)
 
-    # Create tracer colections
+    # Tracer collections are owned (and reused) by the tracers
     status = 0
-    clt1, status = lib.cl_tracer_collection_t_new(status)
-    clt2, status = lib.cl_tracer_collection_t_new(status)
-    for t in tracer1._trc:
-        status = lib.add_cl_tracer_to_collection(clt1, t, status)
-    for t in tracer2._trc:
-        status = lib.add_cl_tracer_to_collection(clt2, t, status)
+    clt1 = tracer1._get_collection()
+    clt2 = tracer2._get_collection()
 
     ell_use = np.atleast_1d(ell)
 
@@ -144,7 +155,9 @@ def angular_cl(
     ell_use_limber = ell_use[ell_use > l_limber]
     # Return Cl values, according to whether ell is an array or not
     if len(ell_use_limber) > 0:
-        cl_limber, status = lib.angular_cl_vec_limber(
+        cl_vec_limber = (lib.angular_cl_vec_limber if limber_order == 1
+                         else lib.angular_cl_vec_limber_extended)
+        cl_limber, status = cl_vec_limber(
             cosmo.cosmo,
             clt1,
             clt2,
@@ -162,12 +175,502 @@ def angular_cl(
     if np.ndim(ell) == 0:
         cl = cl[0]
 
-    # Free up tracer collections
-    lib.cl_tracer_collection_t_free(clt1)
-    lib.cl_tracer_collection_t_free(clt2)
-
     if return_meta:
         meta = {"l_limber": l_limber}  # add other things as needed
 
     check(status, cosmo=cosmo)
     return (cl, meta) if return_meta else cl
+
+
+def angular_cl_batch(
+    cosmologies,
+    tracers1,
+    tracers2,
+    ell,
+    *,
+    p_of_k_a=DEFAULT_POWER_SPECTRUM,
+    limber_integration_method="qag_quad"
+):
+    """Calculate the Limber angular power spectra of pairs of tracers in
+    several cosmologies at once.
+
+    This is equivalent to calling :func:`angular_cl` (with Limber's
+    approximation at all multipoles) once per cosmology, but all
+    cosmologies and multipoles are computed in a single parallel region,
+    which makes better use of many threads when evaluating many nearby
+    cosmologies (e.g. the walkers of an ensemble sampler).
+
+    Args:
+        cosmologies (:obj:`list`): :class:`~pyccl.cosmology.Cosmology`
+            objects.
+        tracers1 (:obj:`list`): a :class:`~pyccl.tracers.Tracer` object
+            for each cosmology, created with that cosmology.
+        tracers2 (:obj:`list`): a second :class:`~pyccl.tracers.Tracer`
+            object for each cosmology.
+        ell (:obj:`float` or `array`): Angular multipole(s) at which to
+            evaluate the angular power spectra.
+        p_of_k_a (:class:`~pyccl.pk2d.Pk2D`, :obj:`str` or :obj:`list`):
+            3D Power spectrum to project (see :func:`angular_cl`), or a
+            list with one for each cosmology.
+        limber_integration_method (string) : integration method to be used
+            for the Limber integrals (see :func:`angular_cl`).
+
+    Returns:
+        `array`: Angular (cross-)power spectra, with shape
+        ``(len(cosmologies), ell.size)``. The last dimension is squeezed
+        if ``ell`` is a scalar.
+    """
+    n_cl = len(cosmologies)
+    if not (len(tracers1) == len(tracers2) == n_cl):
+        raise ValueError("`cosmologies`, `tracers1` and `tracers2` must "
+                         "have the same length.")
+    if n_cl == 0:
+        raise ValueError("`cosmologies` must not be empty.")
+    if isinstance(p_of_k_a, (list, tuple)):
+        if len(p_of_k_a) != n_cl:
+            raise ValueError("`p_of_k_a` must have one entry per "
+                             "cosmology.")
+        pks = p_of_k_a
+    else:
+        pks = [p_of_k_a]*n_cl
+    if limber_integration_method not in integ_types:
+        raise ValueError(
+            "Limber integration method %s not supported"
+            % limber_integration_method
+        )
+
+    ell_use = np.atleast_1d(np.array(ell, dtype=float))
+
+    status = 0
+    batch, status = lib.cl_batch_t_new(status)
+    check(status)
+    for cosmo, tr1, tr2, pk in zip(cosmologies, tracers1, tracers2, pks):
+        cosmo.compute_distances()
+        psp = cosmo.parse_pk2d(pk, is_linear=False)
+        status = lib.add_cl_batch(batch, cosmo.cosmo, tr1._get_collection(),
+                                  tr2._get_collection(), psp, status)
+
+    if status == 0:
+        cl, status = lib.angular_cl_batch_vec_limber(
+            batch, ell_use, integ_types[limber_integration_method],
+            n_cl*ell_use.size, status)
+
+    lib.cl_batch_t_free(batch)
+    check(status, cosmo=cosmologies[0])
+
+    cl = cl.reshape([n_cl, ell_use.size])
+    if np.ndim(ell) == 0:
+        cl = cl[:, 0]
+    return cl
+
+
+def _get_bandpower_csr(windows):
+    """Turn bandpower windows, as a dense array or a sparse matrix with
+    shape ``(n_bpw, l_max+1)``, into compressed sparse row arrays.
+    """
+    if hasattr(windows, "tocsr"):
+        # Sparse matrices, e.g. from scipy.sparse
+        windows = windows.tocsr()
+        start = windows.indptr
+        ell_nz = windows.indices
+        w_nz = windows.data
+    else:
+        windows = np.asarray(windows, dtype=float)
+        if windows.ndim != 2:
+            raise ValueError("`windows` must be a 2D array.")
+        rows, ell_nz = np.nonzero(windows)
+        w_nz = windows[rows, ell_nz]
+        start = np.concatenate([[0], np.cumsum(np.count_nonzero(windows,
+                                                                axis=1))])
+    if len(start) < 2 or start[-1] == 0:
+        raise ValueError("`windows` must have at least one bandpower "
+                         "with non-zero weights.")
+    return (np.ascontiguousarray(start, dtype=np.intc),
+            np.ascontiguousarray(ell_nz, dtype=np.intc),
+            np.ascontiguousarray(w_nz, dtype=float))
+
+
+def angular_cl_bandpowers(
+    cosmo,
+    tracer1,
+    tracer2,
+    windows,
+    *,
+    p_of_k_a=DEFAULT_POWER_SPECTRUM,
+    limber_integration_method="qag_quad",
+    n_ell_sample=None
+):
+    """Calculate the Limber bandpowers of the angular (cross-)power spectrum
+    of a pair of tracers,
+
+    .. math::
+        B_b = \\sum_\\ell W_{b\\ell}\\,C_\\ell.
+
+    The power spectrum is only computed at the multipoles where the windows
+    are non-zero, and convolved with them in C, without materialising it
+    at every multipole.
+
+    Args:
+        cosmo (:class:`~pyccl.cosmology.Cosmology`): A Cosmology object.
+        tracer1 (:class:`~pyccl.tracers.Tracer`): a Tracer object,
+            of any kind.
+        tracer2 (:class:`~pyccl.tracers.Tracer`): a second Tracer object.
+        windows (`array`): bandpower windows, with shape
+            ``(n_bpw, l_max+1)``, such that ``windows[b, l]`` is the weight
+            of multipole ``l`` in bandpower ``b``. Sparse matrices (e.g.
+            from :mod:`scipy.sparse`) are also accepted.
+        p_of_k_a (:class:`~pyccl.pk2d.Pk2D`, :obj:`str` or :obj:`None`): 3D
+            Power spectrum to project (see :func:`angular_cl`).
+        limber_integration_method (string) : integration method to be used
+            for the Limber integrals (see :func:`angular_cl`).
+        n_ell_sample (:obj:`int`): if not ``None``, the power spectrum is
+            computed at this many multipoles (at least 4), evenly spaced in
+            :math:`\\log(\\ell+1)` over the support of the windows, and
+            interpolated with a cubic spline. This is much faster for
+            broad windows, at the cost of interpolation errors that should
+            be checked against the default (exact) calculation.
+
+    Returns:
+        `array`: bandpowers, with shape ``(n_bpw,)``.
+    """
+    if limber_integration_method not in integ_types:
+        raise ValueError(
+            "Limber integration method %s not supported"
+            % limber_integration_method
+        )
+    if n_ell_sample is None:
+        n_ell_sample = 0
+    elif n_ell_sample < 4:
+        raise ValueError("`n_ell_sample` must be at least 4.")
+    start, ell_nz, w_nz = _get_bandpower_csr(windows)
+
+    cosmo.compute_distances()
+    psp = cosmo.parse_pk2d(p_of_k_a, is_linear=False)
+
+    status = 0
+    bpw, status = lib.bandpowers_new(start, ell_nz, w_nz, n_ell_sample,
+                                     status)
+    check(status)
+
+    bp, status = lib.angular_cl_vec_limber_bandpowers(
+        cosmo.cosmo, tracer1._get_collection(), tracer2._get_collection(),
+        psp, bpw, integ_types[limber_integration_method],
+        len(start)-1, status)
+
+    lib.bandpowers_t_free(bpw)
+    check(status, cosmo=cosmo)
+    return bp
+
+
+def angular_data_vector(
+    cosmo,
+    pairs,
+    *,
+    ell=None,
+    theta=None,
+    scale_cuts=None,
+    ell_sample=None,
+    p_of_k_a=DEFAULT_POWER_SPECTRUM,
+    limber_integration_method="qag_quad"
+):
+    """Calculate a data vector made of Limber angular power spectra and
+    angular correlation functions (e.g. a 3x2pt data vector) in one call.
+
+    All the Limber integrals are computed in a single parallel pass.
+    Correlation functions are obtained with FFTLog from power spectra
+    sampled at ``ell_sample`` (see :func:`~pyccl.correlations.correlation`).
+    Correlation functions of the same pair of tracers (e.g.
+    :math:`\\xi_+` and :math:`\\xi_-`) share their power spectrum, and all
+    correlation functions with the same Bessel order are transformed
+    together.
+
+    Args:
+        cosmo (:class:`~pyccl.cosmology.Cosmology`): A Cosmology object.
+        pairs (:obj:`list`): elements of the data vector, each one a tuple
+            ``(tracer1, tracer2, type)``, where ``type`` is ``'cl'`` for an
+            angular power spectrum, or one of the correlation function
+            types of :func:`~pyccl.correlations.correlation` (``'NN'``,
+            ``'NG'``, ``'GG+'`` or ``'GG-'``).
+        ell (`array`): multipoles at which power spectra are evaluated.
+            Required if any element is a power spectrum.
+        theta (`array`): angular separations, in degrees, at which
+            correlation functions are evaluated. Required if any element
+            is a correlation function.
+        scale_cuts (:obj:`list`): ``(x_min, x_max)`` for each element. Only
+            multipoles (or angles) between these limits are kept. ``None``
+            (for the whole list, or for any element) means no cuts.
+        ell_sample (`array`): increasing multipoles at which power spectra
+            are computed before being transformed into correlation
+            functions. If ``None``, 200 logarithmically spaced values between
+            2 and 30000 are used.
+        p_of_k_a (:class:`~pyccl.pk2d.Pk2D`, :obj:`str` or :obj:`None`): 3D
+            Power spectrum to project (see :func:`angular_cl`).
+        limber_integration_method (string) : integration method to be used
+            for the Limber integrals (see :func:`angular_cl`).
+
+    Returns:
+        `array`: data vector, made of the values of each element (in the
+        order of ``pairs``) at the multipoles or angles that pass its
+        scale cuts.
+    """
+    from .correlations import correlation_types
+
+    if limber_integration_method not in integ_types:
+        raise ValueError(
+            "Limber integration method %s not supported"
+            % limber_integration_method
+        )
+    if scale_cuts is None:
+        scale_cuts = [None]*len(pairs)
+    if len(scale_cuts) != len(pairs):
+        raise ValueError("`scale_cuts` must have one entry per element.")
+
+    types = [p[2] for p in pairs]
+    for t in types:
+        if t != "cl" and t not in correlation_types:
+            raise ValueError(f"Invalid data vector element type {t}.")
+    if ell is None:
+        if "cl" in types:
+            raise ValueError("`ell` is needed for power spectra.")
+        ell = []
+    if theta is None:
+        if any(t != "cl" for t in types):
+            raise ValueError("`theta` is needed for correlation functions.")
+        theta = []
+    if ell_sample is None:
+        ell_sample = np.geomspace(2., 3E4, 200)
+    ell_use = np.atleast_1d(np.array(ell, dtype=float))
+    theta_use = np.atleast_1d(np.array(theta, dtype=float))
+    ell_sample = np.atleast_1d(np.array(ell_sample, dtype=float))
+    if not (np.diff(ell_sample) > 0).all():
+        raise ValueError("ell_sample values must be monotonically increasing")
+
+    cosmo.compute_distances()
+    psp = cosmo.parse_pk2d(p_of_k_a, is_linear=False)
+
+    status = 0
+    dv, status = lib.data_vector_t_new(status)
+    check(status)
+    for (tr1, tr2, t), cuts in zip(pairs, scale_cuts):
+        x_min, x_max = (-np.inf, np.inf) if cuts is None else cuts
+        corr_type = 0 if t == "cl" else correlation_types[t]
+        status = lib.add_data_vector_pair(dv, tr1._get_collection(),
+                                          tr2._get_collection(), corr_type,
+                                          x_min, x_max, status)
+
+    if status == 0:
+        nout = lib.data_vector_size(dv, ell_use, theta_use)
+        out, status = lib.angular_data_vector_vec_limber(
+            cosmo.cosmo, psp, dv, ell_use, theta_use, ell_sample,
+            integ_types[limber_integration_method], nout, status)
+
+    lib.data_vector_t_free(dv)
+    check(status, cosmo=cosmo)
+    return out
+
+
+def angular_cl_derivatives(
+    cosmo,
+    tracer1,
+    tracer2,
+    ell,
+    *,
+    dp_of_k_a=None,
+    dtracer1=None,
+    dtracer2=None,
+    p_of_k_a=DEFAULT_POWER_SPECTRUM
+):
+    """Calculate the derivatives of the Limber angular power spectrum of a
+    pair of tracers with respect to a set of parameters.
+
+    Given the derivatives of the radial kernels and of the power spectrum
+    with respect to each parameter :math:`\\theta_i`, this computes
+
+    .. math::
+        \\frac{\\partial C_\\ell}{\\partial\\theta_i} =
+        \\int \\frac{d\\chi}{\\chi^2}\\left[\\partial_i K_1\\,K_2\\,P
+        + K_1\\,\\partial_i K_2\\,P + K_1\\,K_2\\,\\partial_i P\\right],
+
+    for all parameters in a single pass. All parameters share the same
+    quadrature nodes (those of the ``'spline'`` Limber integration method),
+    and the tracers and power spectrum are only evaluated once per node.
+    The derivatives of the kernels and power spectrum must be taken at
+    fixed comoving distance and wavenumber, and the transfer functions of
+    the tracers are assumed not to depend on the parameters. See
+    :func:`angular_cl_gradient` for a way to build these inputs from a
+    function that creates the tracers for a given cosmology.
+
+    Args:
+        cosmo (:class:`~pyccl.cosmology.Cosmology`): A Cosmology object.
+        tracer1 (:class:`~pyccl.tracers.Tracer`): a Tracer object,
+            of any kind.
+        tracer2 (:class:`~pyccl.tracers.Tracer`): a second Tracer object.
+        ell (:obj:`float` or `array`): Angular multipole(s) at which to
+            evaluate the derivatives.
+        dp_of_k_a (:obj:`list`): derivative of the power spectrum with
+            respect to each parameter, as :class:`~pyccl.pk2d.Pk2D` objects
+            created with ``is_logp=False`` (or ``None`` if the power
+            spectrum does not depend on that parameter).
+        dtracer1 (:obj:`list`): derivative of ``tracer1`` with respect to
+            each parameter, as :class:`~pyccl.tracers.Tracer` objects (or
+            ``None``). See :meth:`~pyccl.tracers.Tracer.with_kernels`.
+        dtracer2 (:obj:`list`): same as ``dtracer1`` for ``tracer2``.
+        p_of_k_a (:class:`~pyccl.pk2d.Pk2D`, :obj:`str` or :obj:`None`): 3D
+            Power spectrum to project (see :func:`angular_cl`).
+
+    Returns:
+        `array`: derivatives of the angular power spectrum, with shape
+        ``(n_par, ell.size)``. The last dimension is squeezed if ``ell`` is
+        a scalar.
+    """
+    derivs_in = [d for d in (dp_of_k_a, dtracer1, dtracer2) if d is not None]
+    if not derivs_in:
+        raise ValueError("At least one of `dp_of_k_a`, `dtracer1` or "
+                         "`dtracer2` must be provided.")
+    n_par = len(derivs_in[0])
+    if any(len(d) != n_par for d in derivs_in):
+        raise ValueError("`dp_of_k_a`, `dtracer1` and `dtracer2` must "
+                         "have the same length.")
+    dp_of_k_a = [None]*n_par if dp_of_k_a is None else list(dp_of_k_a)
+    dtracer1 = [None]*n_par if dtracer1 is None else list(dtracer1)
+    dtracer2 = [None]*n_par if dtracer2 is None else list(dtracer2)
+    for dp in dp_of_k_a:
+        if dp is not None and dp.psp.is_log:
+            raise ValueError("Power spectrum derivatives must be Pk2D "
+                             "objects with is_logp=False.")
+
+    ell_use = np.atleast_1d(np.array(ell, dtype=float))
+
+    cosmo.compute_distances()
+    psp = cosmo.parse_pk2d(p_of_k_a, is_linear=False)
+
+    status = 0
+    clt1 = tracer1._get_collection()
+    clt2 = tracer2._get_collection()
+    derivs, status = lib.cl_derivs_t_new(status)
+    for dp, dt1, dt2 in zip(dp_of_k_a, dtracer1, dtracer2):
+        dclt = [None if dt is None else dt._get_collection()
+                for dt in (dt1, dt2)]
+        dpsp = None if dp is None else dp.psp
+        status = lib.add_cl_deriv(derivs, dclt[0], dclt[1], dpsp, status)
+
+    dcl, status = lib.angular_cl_derivs_vec_limber(
+        cosmo.cosmo, clt1, clt2, psp, derivs, ell_use,
+        n_par*ell_use.size, status)
+
+    lib.cl_derivs_t_free(derivs)
+    check(status, cosmo=cosmo)
+
+    dcl = dcl.reshape([n_par, ell_use.size])
+    if np.ndim(ell) == 0:
+        dcl = dcl[:, 0]
+    return dcl
+
+
+def _tracer_derivative(cosmo, tracer, tracer_p, tracer_m, step):
+    """Finite-difference derivative of the radial kernels of ``tracer``
+    at fixed comoving distance, from the same tracer in two other
+    cosmologies."""
+    if not (len(tracer._trc) == len(tracer_p._trc) == len(tracer_m._trc)):
+        raise ValueError("The tracers created for different cosmologies "
+                         "contain different numbers of contributions.")
+    kernels = []
+    for t, t_p, t_m in zip(tracer._trc, tracer_p._trc, tracer_m._trc):
+        if t.kernel is None:
+            # Constant kernels do not change.
+            chi = np.linspace(t.chi_min, t.chi_max, 16)
+            kernels.append((chi, np.zeros_like(chi)))
+            continue
+        chi, _ = _get_spline1d_arrays(t.kernel.spline)
+        ws = []
+        for tt in (t_p, t_m):
+            status = 0
+            w, status = lib.cl_tracer_get_kernel(tt, chi, chi.size, status)
+            check(status)
+            ws.append(w)
+        kernels.append((chi, (ws[0]-ws[1])/(2*step)))
+    return tracer.with_kernels(cosmo, kernels)
+
+
+def angular_cl_gradient(
+    cosmo,
+    get_tracers,
+    ell,
+    params,
+    *,
+    p_of_k_a=DEFAULT_POWER_SPECTRUM
+):
+    """Calculate the derivatives of the Limber angular power spectrum of a
+    pair of tracers with respect to a set of cosmological parameters.
+
+    The derivatives of the power spectrum and of the tracer kernels at
+    fixed comoving distance are obtained through central finite
+    differences, and then propagated through the Limber integral by
+    :func:`angular_cl_derivatives` in a single pass. This is cheaper and
+    less noisy than differentiating the output of :func:`angular_cl`,
+    since the projection is done only once for all parameters.
+
+    Args:
+        cosmo (:class:`~pyccl.cosmology.Cosmology`): A Cosmology object.
+            Shifted cosmologies are created from its
+            :meth:`~pyccl.cosmology.Cosmology.to_dict` output.
+        get_tracers (:obj:`callable`): function taking a
+            :class:`~pyccl.cosmology.Cosmology` and returning a pair of
+            :class:`~pyccl.tracers.Tracer` objects.
+        ell (:obj:`float` or `array`): Angular multipole(s) at which to
+            evaluate the derivatives.
+        params (:obj:`dict`): names of the cosmological parameters to
+            differentiate with respect to, and the finite-difference step
+            to use for each of them.
+        p_of_k_a (:class:`~pyccl.pk2d.Pk2D` or :obj:`str`): 3D Power
+            spectrum to project. If a string, it must correspond to one of
+            the non-linear power spectra stored in each cosmology.
+
+    Returns:
+        `array`: derivatives of the angular power spectrum, with shape
+        ``(len(params), ell.size)`` and parameters in the order of
+        ``params``.
+    """
+    from . import Cosmology, Pk2D
+
+    def get_pk(c):
+        if isinstance(p_of_k_a, str):
+            c.compute_nonlin_power()
+            return c.get_nonlin_power(p_of_k_a)
+        return p_of_k_a
+
+    tracer1, tracer2 = get_tracers(cosmo)
+    a_arr, lk_arr, _ = get_pk(cosmo).get_spline_arrays()
+    chi_arr = cosmo.comoving_radial_distance(a_arr)
+    k_arr = np.exp(lk_arr)
+    pars = cosmo.to_dict()
+
+    dpks, dtrs1, dtrs2 = [], [], []
+    for name, step in params.items():
+        if name not in pars or pars[name] is None:
+            raise KeyError(f"Cannot vary parameter {name}.")
+        cosmos = [Cosmology(**{**pars, name: pars[name] + s})
+                  for s in (step, -step)]
+
+        # Power spectrum derivative at fixed distance
+        pks = []
+        for c in cosmos:
+            pk = get_pk(c)
+            a_c = c.scale_factor_of_chi(chi_arr)
+            pks.append(np.array([pk(k_arr, aa, c) for aa in a_c]))
+        dpks.append(Pk2D(a_arr=a_arr, lk_arr=lk_arr,
+                         pk_arr=(pks[0]-pks[1])/(2*step), is_logp=False))
+
+        # Kernel derivatives at fixed distance
+        trs = [get_tracers(c) for c in cosmos]
+        dtrs1.append(_tracer_derivative(cosmo, tracer1,
+                                        trs[0][0], trs[1][0], step))
+        if tracer2 is tracer1:
+            dtrs2.append(dtrs1[-1])
+        else:
+            dtrs2.append(_tracer_derivative(cosmo, tracer2,
+                                            trs[0][1], trs[1][1], step))
+
+    return angular_cl_derivatives(cosmo, tracer1, tracer2, ell,
+                                  dp_of_k_a=dpks, dtracer1=dtrs1,
+                                  dtracer2=dtrs2, p_of_k_a=p_of_k_a)
@@ -1,6 +1,7 @@
 __all__ = ("CorrelationMethods", "CorrelationTypes", "correlation",
            "correlation_3d", "correlation_multipole", "correlation_3dRsd",
-           "correlation_3dRsd_avgmu", "correlation_pi_sigma",)
+           "correlation_3dRsd_avgmu", "correlation_pi_sigma",
+           "correlation_projected",)
 
 from enum import Enum
 import numpy as np
@@ -361,3 +362,75 @@ def correlation_pi_sigma(cosmo, *, pi, sigma, a, beta,
     if scalar:
         return xis[0]
     return xis
+
+
+def correlation_projected(cosmo, *, rp, a, pi_max=None, beta=None,
+                          p_of_k_a=DEFAULT_POWER_SPECTRUM):
+    r"""Compute the projected correlation function
+
+    .. math::
+        w_p(r_p) = 2\int_0^{\pi_{\rm max}} d\pi\,
+        \xi\left(\sqrt{r_p^2+\pi^2},\mu=\pi/\sqrt{r_p^2+\pi^2}\right).
+
+    For :math:`\pi_{\rm max}\rightarrow\infty` this is
+
+    .. math::
+        w_p(r_p) = \frac{1}{2\pi}\int dk\,k\,P(k)\,J_0(kr_p),
+
+    which is computed with a single FFTLog transform for all scale factors.
+    For finite :math:`\pi_{\rm max}`, the line-of-sight integral of
+    :math:`\xi` beyond :math:`\pi_{\rm max}` is subtracted. If ``beta`` is
+    provided, :math:`\xi(s,\mu)` includes the linear redshift-space
+    distortion multipoles (see :func:`correlation_3dRsd`). Note that these
+    do not change :math:`w_p` for an infinite :math:`\pi_{\rm max}`.
+
+    Args:
+        cosmo (:class:`~pyccl.cosmology.Cosmology`): A Cosmology object.
+        rp (:obj:`float` or `array`): projected separation(s) (in Mpc).
+        a (:obj:`float` or `array`): scale factor(s).
+        pi_max (:obj:`float`): maximum line-of-sight separation (in Mpc).
+            If ``None``, the integral extends to infinity.
+        beta (:obj:`float` or `array`): growth rate divided by galaxy bias,
+            either a single value or one per scale factor. If ``None``,
+            redshift-space distortions are ignored.
+        p_of_k_a (:class:`~pyccl.pk2d.Pk2D`, :obj:`str` or :obj:`None`): 3D Power spectrum
+            to integrate. If a string, it must correspond to one of the
+            non-linear power spectra stored in `cosmo` (e.g.
+            `'delta_matter:delta_matter'`).
+
+    Returns:
+        Value(s) of the projected correlation function (in Mpc). The
+        output has shape ``(n_a, n_rp)``, with the dimensions of scalar
+        ``a`` and ``rp`` removed.
+    """ # noqa
+    cosmo.compute_nonlin_power()
+
+    cosmo_in = cosmo
+    cosmo = cosmo.cosmo
+
+    psp = cosmo_in.parse_pk2d(p_of_k_a)
+
+    status = 0
+
+    a_use = np.atleast_1d(np.asarray(a, dtype=float))
+    rp_use = np.atleast_1d(np.asarray(rp, dtype=float))
+    if pi_max is None:
+        pi_max = -1.
+    elif pi_max <= 0:
+        raise ValueError("`pi_max` must be positive.")
+    if beta is None:
+        beta = np.array([])
+    else:
+        beta = np.broadcast_to(np.asarray(beta, dtype=float),
+                               a_use.shape).copy()
+
+    wp, status = lib.correlation_projected_vec(cosmo, psp, a_use, beta,
+                                               pi_max, rp_use,
+                                               a_use.size*rp_use.size, status)
+    check(status, cosmo_in)
+    wp = wp.reshape([a_use.size, rp_use.size])
+    if np.ndim(rp) == 0:
+        wp = np.squeeze(wp, axis=-1)
+    if np.ndim(a) == 0:
+        wp = np.squeeze(wp, axis=0)
+    return wp
@@ -30,9 +30,10 @@ from scipy.interpolate import Akima1DInterpolator
 import numpy as np
 
 from . import (
-    CCLError, CCLObject, CCLParameters, CosmologyParams,
-    DEFAULT_POWER_SPECTRUM, DefaultParams, Pk2D, check, lib,
-    unlock_instance, emulators, baryons, modified_gravity)
+    CCLError, CCLObject, CCLParameters, Caching, CosmologyParams,
+    DEFAULT_POWER_SPECTRUM, DefaultParams, Pk2D, check, hash_, lib,
+    UnlockInstance, unlock_instance, emulators, baryons, modified_gravity)
+from .pyutils import _get_spline2d_arrays
 from . import physical_constants as const
 
 
@@ -598,12 +599,40 @@ class Cosmology(CCLObject):
 
         return pk
 
+    def _load_or_compute_linear_power(self):
+        """Return the linear power spectrum, reading it from the on-disk
+        cache if it is enabled and the transfer function is expensive.
+        """
+        disk = Caching.get_disk_cache()
+        # CAMB computes the non-linear power spectrum alongside the linear
+        # one, so we can't skip the call to `_compute_linear_power`.
+        if (disk is None
+                or not self.transfer_function_type.startswith("boltzmann")
+                or self.matter_power_spectrum_type == "camb"):
+            return self._compute_linear_power()
+
+        key = hex(hash_(("pk_linear", repr(self))))
+        arrs = disk.load(key)
+        if arrs is not None:
+            return Pk2D(**arrs)
+
+        pk = self._compute_linear_power()
+        if pk:
+            # Store the raw spline data, so that the round trip is exact.
+            a_arr, lk_arr, pk_arr = _get_spline2d_arrays(pk.psp.fka)
+            disk.save(key, {"a_arr": a_arr, "lk_arr": lk_arr,
+                            "pk_arr": pk_arr, "is_logp": bool(pk.psp.is_log),
+                            "extrap_order_lok": pk.extrap_order_lok,
+                            "extrap_order_hik": pk.extrap_order_hik})
+        return pk
+
     @unlock_instance(mutate=False)
     def compute_linear_power(self):
         """Compute the linear power spectrum."""
         if self.has_linear_power:
             return
-        self._pk_lin[DEFAULT_POWER_SPECTRUM] = self._compute_linear_power()
+        self._pk_lin[DEFAULT_POWER_SPECTRUM] = \
+            self._load_or_compute_linear_power()
 
     def _compute_nonlin_power(self):
         """Return the non-linear power spectrum."""
@@ -687,6 +716,39 @@ class Cosmology(CCLObject):
             raise KeyError(f"Power spectrum {name} does not exist.")
         return pk
 
+    def get_memory_report(self):
+        """Get the memory footprint of the C-level data held by this
+        cosmology, broken down by component.
+
+        Returns:
+            :obj:`dict`: number of bytes held by the parameter arrays
+            (``'params'``), the distance splines (``'background'``), the
+            growth splines (``'growth'``), the :math:`\\sigma(M)` spline
+            (``'sigma'``), the RSD correlation splines (``'rsd'``), and the
+            linear and non-linear power spectra (``'pk_linear'`` and
+            ``'pk_nonlin'``). The ``'total'`` entry holds the sum of all
+            of these. Power spectra shared between the linear and non-linear
+            containers are only counted once.
+        """
+        rep = lib.memory_report_t()
+        lib.memory_report(self.cosmo, rep)
+        out = {"params": rep.params, "background": rep.background,
+               "growth": rep.growth, "sigma": rep.sigma, "rsd": rep.rsd}
+
+        seen = set()
+        for label, pks in zip(["pk_linear", "pk_nonlin"],
+                              [self._pk_lin, self._pk_nl]):
+            out[label] = 0
+            for pk in pks.values():
+                if pk is None or id(pk) in seen:
+                    continue
+                seen.add(id(pk))
+                out[label] += pk.nbytes
+
+        # `rep.total` also includes the ccl_cosmology struct itself.
+        out["total"] = rep.total + out["pk_linear"] + out["pk_nonlin"]
+        return out
+
     @property
     def has_distances(self):
         """Checks if the distances have been precomputed."""
@@ -697,6 +759,12 @@ class Cosmology(CCLObject):
         """Checks if the growth function has been precomputed."""
         return bool(self.cosmo.computed_growth)
 
+    @property
+    def has_halo_background(self):
+        """Checks if the halo model background splines have been
+        precomputed."""
+        return bool(self.cosmo.computed_halo_background)
+
     @property
     def has_linear_power(self):
         """Checks if the linear power spectra have been precomputed."""
@@ -847,6 +915,13 @@ class CosmologyCalculator(Cosmology):
             computed. The only non-linear model supported is ``'halofit'``,
             corresponding to the "HALOFIT" transformation of
             `Takahashi et al. 2012 <https://arxiv.org/abs/1208.2701>`_.
+
+    .. note:: Arrays sampled on a common grid are ingested in bulk: if
+              ``background`` and ``growth`` share the same ``'a'`` array,
+              it is checked once and all their splines are built in a
+              single call, and if ``pk_linear`` and ``pk_nonlin`` share
+              the same ``'a'`` and ``'k'`` arrays, the grid is checked
+              and its logarithm taken once for all power spectra.
     """ # noqa
     __eq_attrs__ = ("_params_init_kwargs", "_config_init_kwargs",
                     "_accuracy_params", "_input_arrays",)
@@ -870,14 +945,19 @@ class CosmologyCalculator(Cosmology):
                               "pk_linear": pk_linear, "pk_nonlin": pk_nonlin,
                               "nonlinear_model": nonlinear_model}
 
-        if background is not None:
-            self._init_background(background)
-        if growth is not None:
-            self._init_growth(growth)
+        if (background is not None and growth is not None
+                and self._same_grid(background["a"], growth["a"])):
+            self._init_background_growth(background, growth)
+        else:
+            if background is not None:
+                self._init_background(background)
+            if growth is not None:
+                self._init_growth(growth)
+        grid = None
         if pk_linear is not None:
-            self._init_pk_linear(pk_linear)
+            grid = self._init_pk_linear(pk_linear)
         if pk_nonlin is not None:
-            self._init_pk_nonlinear(pk_nonlin, nonlinear_model)
+            self._init_pk_nonlinear(pk_nonlin, nonlinear_model, grid)
         self._apply_nonlinear_model(nonlinear_model)
 
     def _check_scale_factor(self, a):
@@ -896,6 +976,10 @@ class CosmologyCalculator(Cosmology):
             raise ValueError(f"Could not parse power spectrum {name}. "
                              "Label must be of the form 'q1:q2'.")
 
+    def _same_grid(self, a1, a2):
+        return a1 is a2 or (np.shape(a1) == np.shape(a2)
+                            and np.array_equal(a1, a2))
+
     def _init_background(self, background):
         a, chi, E = background["a"], background["chi"], background["h_over_h0"]
         self._check_input(a, chi, E)
@@ -911,52 +995,71 @@ class CosmologyCalculator(Cosmology):
         status = lib.cosmology_growth_from_input(self.cosmo, a, gz, fz, status)
         check(status, self)
 
-    def _init_pk_linear(self, pk_linear):
-        a, lk = pk_linear["a"], np.log(pk_linear["k"])
-        self._check_scale_factor(a)
-        self.compute_growth()  # needed for high-z extrapolation
-        na, nk = a.size, lk.size
+    def _init_background_growth(self, background, growth):
+        # Background and growth share their scale factors, so the grid
+        # is checked once and all the splines are built in a single call.
+        a, chi, E = background["a"], background["chi"], background["h_over_h0"]
+        gz, fz = growth["growth_factor"], growth["growth_rate"]
+        self._check_input(a, chi, E)
+        if not a.shape == gz.shape == fz.shape:
+            raise ValueError("Shape mismatch of input arrays.")
+        status = 0
+        status = lib.cosmology_background_from_input(self.cosmo, a, chi, E,
+                                                     gz, fz, status)
+        check(status, self)
 
-        if DEFAULT_POWER_SPECTRUM not in pk_linear:
-            raise ValueError("pk_linear does not contain "
-                             f"{DEFAULT_POWER_SPECTRUM}")
+    def _pk_grid(self, pk_dict, grid=None):
+        """Check the scale factors of a power spectrum dictionary and take
+        the logarithm of its wavenumbers, unless they match ``grid``, the
+        ``(a, k, lk)`` tuple returned for a previous dictionary."""
+        a, k = pk_dict["a"], pk_dict["k"]
+        if (grid is not None and self._same_grid(a, grid[0])
+                and self._same_grid(k, grid[1])):
+            return grid
+        a = np.ascontiguousarray(a, dtype=float)
+        self._check_scale_factor(a)
+        return a, k, np.log(k)
 
-        pk_names = set(pk_linear.keys()) - set(["a", "k"])
+    def _init_pk(self, pk_dict, grid):
+        a, _, lk = grid
+        na, nk = a.size, lk.size
+        pks = {}
+        pk_names = set(pk_dict.keys()) - set(["a", "k"])
         for name in pk_names:
             self._check_label(name)
-            pk = pk_linear[name]
+            pk = pk_dict[name]
             if pk.shape != (na, nk):
                 raise ValueError("Power spectrum shape mismatch. "
                                  f"Expected {(na, nk)}. Received {pk.shape}.")
-            # Spline in log-space if the P(k) is positive-definite
-            use_log = (pk > 0).all()
-            if use_log:
-                pk = np.log(pk)
-            self._pk_lin[name] = Pk2D(a_arr=a, lk_arr=lk, pk_arr=pk,
-                                      is_logp=use_log)
-
-    def _init_pk_nonlinear(self, pk_nonlin, nonlinear_model):
-        a, lk = pk_nonlin["a"], np.log(pk_nonlin["k"])
-        self._check_scale_factor(a)
-        na, nk = a.size, lk.size
+            # The grid is already checked, so build the spline directly.
+            # The logarithm is taken in C if the P(k) is positive-definite.
+            pks[name] = psp = Pk2D.__new__(Pk2D)
+            status = 0
+            with UnlockInstance(psp):
+                psp.psp, status = lib.set_pk2d_new_from_input(
+                    lk, a, np.ravel(pk), 1, 2, status)
+            check(status, self)
+        return pks
+
+    def _init_pk_linear(self, pk_linear):
+        grid = self._pk_grid(pk_linear)
+        self.compute_growth()  # needed for high-z extrapolation
+
+        if DEFAULT_POWER_SPECTRUM not in pk_linear:
+            raise ValueError("pk_linear does not contain "
+                             f"{DEFAULT_POWER_SPECTRUM}")
+
+        self._pk_lin.update(self._init_pk(pk_linear, grid))
+        return grid
+
+    def _init_pk_nonlinear(self, pk_nonlin, nonlinear_model, grid=None):
+        grid = self._pk_grid(pk_nonlin, grid)
 
         if DEFAULT_POWER_SPECTRUM not in pk_nonlin and nonlinear_model is None:
             raise ValueError(f"{DEFAULT_POWER_SPECTRUM} not specified in "
                              "`pk_nonlin` and `nonlinear_model` is None")
 
-        pk_names = set(pk_nonlin.keys()) - set(["a", "k"])
-        for name in pk_names:
-            self._check_label(name)
-            pk = pk_nonlin[name]
-            if pk.shape != (na, nk):
-                raise ValueError("Power spectrum shape mismatch. "
-                                 f"Expected {(na, nk)}. Received {pk.shape}.")
-            # Spline in log-space if the P(k) is positive-definite
-            use_log = (pk > 0).all()
-            if use_log:
-                pk = np.log(pk)
-            self._pk_nl[name] = Pk2D(a_arr=a, lk_arr=lk, pk_arr=pk,
-                                     is_logp=use_log)
+        self._pk_nl.update(self._init_pk(pk_nonlin, grid))
 
     def _apply_nonlinear_model(self, nonlin_model):
         if nonlin_model is None:
@@ -1,5 +1,5 @@
 __all__ = ("angular_cl_cov_cNG", "sigma2_B_disc", "sigma2_B_from_mask",
-           "angular_cl_cov_SSC",)
+           "angular_cl_cov_SSC", "angular_cl_cov_gaussian",)
 
 import numpy as np
 
@@ -73,26 +73,12 @@ def angular_cl_cov_cNG(cosmo, tracer1, tracer2, *, ell, t_of_kk_a,
 
     tsp = t_of_kk_a.tsp
 
-    # Create tracer colections
+    # Tracer collections are owned (and reused) by the tracers
     status = 0
-    clt1, status = lib.cl_tracer_collection_t_new(status)
-    for t in tracer1._trc:
-        status = lib.add_cl_tracer_to_collection(clt1, t, status)
-    clt2, status = lib.cl_tracer_collection_t_new(status)
-    for t in tracer2._trc:
-        status = lib.add_cl_tracer_to_collection(clt2, t, status)
-    if tracer3 is None:
-        clt3 = clt1
-    else:
-        clt3, status = lib.cl_tracer_collection_t_new(status)
-        for t in tracer3._trc:
-            status = lib.add_cl_tracer_to_collection(clt3, t, status)
-    if tracer4 is None:
-        clt4 = clt2
-    else:
-        clt4, status = lib.cl_tracer_collection_t_new(status)
-        for t in tracer4._trc:
-            status = lib.add_cl_tracer_to_collection(clt4, t, status)
+    clt1 = tracer1._get_collection()
+    clt2 = tracer2._get_collection()
+    clt3 = clt1 if tracer3 is None else tracer3._get_collection()
+    clt4 = clt2 if tracer4 is None else tracer4._get_collection()
 
     ell1_use = np.atleast_1d(ell)
     if ell2 is None:
@@ -110,14 +96,6 @@ def angular_cl_cov_cNG(cosmo, tracer1, tracer2, *, ell, t_of_kk_a,
     if np.ndim(ell) == 0:
         cov = np.squeeze(cov, axis=-1)
 
-    # Free up tracer collections
-    lib.cl_tracer_collection_t_free(clt1)
-    lib.cl_tracer_collection_t_free(clt2)
-    if tracer3 is not None:
-        lib.cl_tracer_collection_t_free(clt3)
-    if tracer4 is not None:
-        lib.cl_tracer_collection_t_free(clt4)
-
     check(status, cosmo=cosmo_in)
     return cov
 
@@ -325,26 +303,12 @@ def angular_cl_cov_SSC(cosmo, tracer1, tracer2, *, ell, t_of_kk_a,
 
     tsp = t_of_kk_a.tsp
 
-    # Create tracer colections
+    # Tracer collections are owned (and reused) by the tracers
     status = 0
-    clt1, status = lib.cl_tracer_collection_t_new(status)
-    for t in tracer1._trc:
-        status = lib.add_cl_tracer_to_collection(clt1, t, status)
-    clt2, status = lib.cl_tracer_collection_t_new(status)
-    for t in tracer2._trc:
-        status = lib.add_cl_tracer_to_collection(clt2, t, status)
-    if tracer3 is None:
-        clt3 = clt1
-    else:
-        clt3, status = lib.cl_tracer_collection_t_new(status)
-        for t in tracer3._trc:
-            status = lib.add_cl_tracer_to_collection(clt3, t, status)
-    if tracer4 is None:
-        clt4 = clt2
-    else:
-        clt4, status = lib.cl_tracer_collection_t_new(status)
-        for t in tracer4._trc:
-            status = lib.add_cl_tracer_to_collection(clt4, t, status)
+    clt1 = tracer1._get_collection()
+    clt2 = tracer2._get_collection()
+    clt3 = clt1 if tracer3 is None else tracer3._get_collection()
+    clt4 = clt2 if tracer4 is None else tracer4._get_collection()
 
     ell1_use = np.atleast_1d(ell)
     if ell2 is None:
@@ -366,13 +330,88 @@ def angular_cl_cov_SSC(cosmo, tracer1, tracer2, *, ell, t_of_kk_a,
     if np.ndim(ell) == 0:
         cov = np.squeeze(cov, axis=-1)
 
-    # Free up tracer collections
-    lib.cl_tracer_collection_t_free(clt1)
-    lib.cl_tracer_collection_t_free(clt2)
-    if tracer3 is not None:
-        lib.cl_tracer_collection_t_free(clt3)
-    if tracer4 is not None:
-        lib.cl_tracer_collection_t_free(clt4)
-
     check(status, cosmo=cosmo_in)
     return cov
+
+
+def angular_cl_cov_gaussian(ell, cls, *, noise=None, fsky=1.,
+                            delta_ell=None, pairs=None, dense=False):
+    """Calculate the Gaussian covariance of a set of angular power spectra
+    between ``N`` tracers. For power spectra :math:`C_\\ell^{ab}` and
+    :math:`C_\\ell^{cd}` it is given by:
+
+    .. math::
+        {\\rm Cov}_{\\rm G}(\\ell,\\ell')=\\delta_{\\ell\\ell'}
+        \\frac{S^{ac}_\\ell S^{bd}_\\ell+S^{ad}_\\ell S^{bc}_\\ell}
+        {(2\\ell+1)\\,f_{\\rm sky}\\,\\Delta\\ell},
+
+    where :math:`S^{xy}_\\ell=C^{xy}_\\ell+N^{xy}_\\ell` is the sum of the
+    signal and noise power spectra, and :math:`\\Delta\\ell` is the width
+    of each bandpower. All the blocks are computed in a single call.
+
+    Args:
+        ell (`array`): multipoles (or bandpower centres).
+        cls (`array`): power spectra of all pairs of tracers, with shape
+            ``(N, N, n_ell)``. It must be symmetric in its first two
+            indices.
+        noise (`array`): noise power spectra, with the same shape as
+            ``cls``. If ``None``, no noise is added.
+        fsky (:obj:`float`): sky fraction.
+        delta_ell (:obj:`float` or `array`): width of each bandpower. If
+            ``None``, unit widths are used.
+        pairs (`array`): pairs of tracer indices ``(i, j)`` making up the
+            data vector, with shape ``(n_pairs, 2)``. If ``None``, all pairs
+            with ``i <= j`` are used, in row-major order.
+        dense (:obj:`bool`): if ``True``, return the full covariance matrix
+            of the data vector. Otherwise only the diagonal in :math:`\\ell`
+            of each block is returned.
+
+    Returns:
+        `array`: if ``dense`` is ``False``, an array with shape \
+            ``(n_pairs, n_pairs, n_ell)`` such that ``out[p, q, il]`` is the \
+            covariance between power spectra ``pairs[p]`` and ``pairs[q]`` \
+            at ``ell[il]``. Otherwise, an array with shape \
+            ``(n_pairs*n_ell, n_pairs*n_ell)``, where the data vector is \
+            ordered by pair first and multipole second.
+    """
+    ell_use = np.atleast_1d(np.asarray(ell, dtype=float))
+    nell = ell_use.size
+    cls = np.asarray(cls, dtype=float)
+    if (cls.ndim != 3) or (cls.shape[0] != cls.shape[1]) or \
+            (cls.shape[2] != nell):
+        raise ValueError("`cls` must have shape (N, N, n_ell).")
+    ntr = cls.shape[0]
+
+    if noise is None:
+        noise_use = np.zeros(0)
+    else:
+        noise_use = np.broadcast_to(noise, cls.shape).flatten()
+    if delta_ell is None:
+        dell = np.zeros(0)
+    else:
+        dell = np.broadcast_to(delta_ell, (nell,)).astype(float)
+
+    if pairs is None:
+        pair_i, pair_j = np.triu_indices(ntr)
+    else:
+        pairs = np.atleast_2d(pairs)
+        if pairs.shape[-1] != 2:
+            raise ValueError("`pairs` must have shape (n_pairs, 2).")
+        pair_i, pair_j = pairs.T
+    pair_i = np.ascontiguousarray(pair_i, dtype=np.intc)
+    pair_j = np.ascontiguousarray(pair_j, dtype=np.intc)
+    npairs = pair_i.size
+
+    status = 0
+    cov, status = lib.angular_cov_gaussian_vec(
+        ntr, ell_use, dell, cls.flatten(), noise_use, fsky,
+        pair_i, pair_j, npairs*npairs*nell, status)
+    check(status)
+    cov = cov.reshape([npairs, npairs, nell])
+
+    if not dense:
+        return cov
+    out = np.zeros([npairs, nell, npairs, nell])
+    idx = np.arange(nell)
+    out[:, idx, :, idx] = np.transpose(cov, axes=(2, 0, 1))
+    return out.reshape([npairs*nell, npairs*nell])
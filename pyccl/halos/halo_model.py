@@ -3,7 +3,7 @@ __all__ = ("HMCalculator",)
 import numpy as np
 from scipy.integrate import simpson
 
-from .. import CCLAutoRepr, unlock_instance
+from .. import CCLAutoRepr, unlock_instance, lib, check
 from .. import physical_constants as const
 from . import MassDef
 from ..pyutils import _spline_integrate
@@ -64,9 +64,18 @@ class HMCalculator(CCLAutoRepr):
         else:
             raise ValueError("Invalid integration method.")
 
+        # Simpson's rule is linear in the integrand, so mass integrals
+        # of outer products over k and k' reduce to matrix products with
+        # fixed quadrature weights. The spline integrator is not.
+        self._mass_weights = None
+        if integration_method_M == "simpson":
+            self._mass_weights = simpson(np.eye(nM), x=self._lmass)
+
         # Cache last results for mass function and halo bias.
         self._cosmo_mf = self._cosmo_bf = None
         self._a_mf = self._a_bf = -1
+        self._cosmo_grid = self._a_grid = None
+        self._mf_grid = self._bf_grid = None
 
     def _integ_simpson(self, fM, log10M):
         return simpson(fM, x=log10M)
@@ -105,6 +114,35 @@ class HMCalculator(CCLAutoRepr):
         if get_bf:
             self._get_halo_bias(cosmo, a, rho0)
 
+    @unlock_instance(mutate=False)
+    def _get_ingredients_grid(self, cosmo, a_arr, *, get_bf):
+        """Compute mass function and halo bias tables of shape
+        ``(N_a, N_M)``, and their low-mass corrections, on a grid of
+        scale factors."""
+        if cosmo != self._cosmo_grid or not np.array_equal(a_arr,
+                                                           self._a_grid):
+            self._mf_grid = self._bf_grid = None
+        rho0 = const.RHO_CRITICAL * cosmo["Omega_m"] * cosmo["h"]**2
+
+        if self._mf_grid is None:
+            mf = np.array([self.mass_function(cosmo, self._mass, aa)
+                           for aa in a_arr])
+            integ = self._integrate_last_axis(mf*self._mass)
+            self._mf_grid = mf, (rho0 - integ) / self._m0
+        if get_bf and self._bf_grid is None:
+            mf = self._mf_grid[0]
+            bf = np.array([self.halo_bias(cosmo, self._mass, aa)
+                           for aa in a_arr])
+            integ = self._integrate_last_axis(mf*bf*self._mass)
+            self._bf_grid = bf, (rho0 - integ) / self._m0
+        self._cosmo_grid, self._a_grid = cosmo, a_arr.copy()  # cache
+
+    def _integrate_last_axis(self, fM):
+        # Mass integral along the last axis of an array of any shape.
+        shape = fM.shape[:-1]
+        fM = fM.reshape([-1, fM.shape[-1]])
+        return self._integrator(fM, self._lmass).reshape(shape)
+
     def _integrate_over_mf(self, array_2):
         #  ∫ dM n(M) f(M)
         i1 = self._integrator(self._mf * array_2, self._lmass)
@@ -115,6 +153,26 @@ class HMCalculator(CCLAutoRepr):
         i1 = self._integrator(self._mf * self._bf * array_2, self._lmass)
         return i1 + self._mbf0 * array_2[..., 0]
 
+    def _integrate_outer_over_mf(self, uk1, uk2, *, get_bf):
+        #  ∫ dM n(M) [b(M)] u_1(k|M) u_2(k'|M), for profiles of shape
+        #  (N_k, N_M), returned with shape (N_k, N_k').
+        if self._mass_weights is None:
+            integ = self._integrate_over_mbf if get_bf else \
+                self._integrate_over_mf
+            return integ(uk1[:, None, :] * uk2[None, :, :])
+
+        w = self._mf * self._mass_weights
+        if get_bf:
+            w *= self._bf
+            w[0] += self._mbf0
+        else:
+            w[0] += self._mf0
+        status = 0
+        out, status = lib.halomod_mass_outer_vec(
+            w, uk1.flatten(), uk2.flatten(), len(uk1)*len(uk2), status)
+        check(status)
+        return out.reshape([len(uk1), len(uk2)])
+
     def integrate_over_massfunc(self, func, cosmo, a):
         """ Returns the integral over mass of a given funcion times
         the mass function:
@@ -136,6 +194,54 @@ class HMCalculator(CCLAutoRepr):
         self._get_ingredients(cosmo, a, get_bf=False)
         return self._integrate_over_mf(fM)
 
+    def integrate_over_massfunc_grid(self, func, cosmo, a, *,
+                                     with_bias=False):
+        """ Returns the integral over mass of a given function times
+        the mass function (and, optionally, the halo bias) for a set of
+        scale factors at once:
+
+        .. math::
+            \\int dM\\,n(M,a)\\,[b(M,a)]\\,f(M,a)
+
+        The mass function and halo bias are tabulated once for all scale
+        factors, and all integrals are carried out in a single
+        vectorized pass.
+
+        Args:
+            func (:obj:`callable`): a function with signature ``f(M, a)``,
+                where ``M`` is an array of halo masses with shape
+                ``(N_M,)`` and ``a`` is an array of scale factors with
+                shape ``(N_a, 1)``. It must return an array with shape
+                ``(N_a, N_M)``, or ``(N_a, ..., N_M)`` if the integrand
+                has additional dimensions.
+            cosmo (:class:`~pyccl.cosmology.Cosmology`): a Cosmology object.
+            a (:obj:`float` or `array`): scale factors.
+            with_bias (:obj:`bool`): if ``True``, the integrand is also
+                weighted by the halo bias.
+
+        Returns:
+            (:obj:`float` or `array`): integral values, with shape
+            ``(N_a, ...)``. If ``a`` is a scalar, the corresponding
+            dimension is squeezed out on output.
+        """ # noqa
+        a_use = np.atleast_1d(a).astype(float)
+        self._get_ingredients_grid(cosmo, a_use, get_bf=with_bias)
+        weight, weight0 = self._mf_grid
+        if with_bias:
+            weight = weight * self._bf_grid[0]
+            weight0 = self._bf_grid[1]
+
+        fM = np.asarray(func(self._mass, a_use[:, None]), dtype=float)
+        # Broadcast the (N_a, N_M) tables over any extra dimensions.
+        extra = (1,) * (fM.ndim - 2)
+        weight = weight.reshape((len(a_use),) + extra + (len(self._mass),))
+        weight0 = weight0.reshape((len(a_use),) + extra)
+
+        out = self._integrate_last_axis(weight * fM) + weight0 * fM[..., 0]
+        if np.ndim(a) == 0:
+            out = np.squeeze(out, axis=0)
+        return out
+
     def number_counts(self, cosmo, *, selection,
                       a_min=None, a_max=1.0, na=128):
         """ Solves the integral:
@@ -370,12 +476,18 @@ class HMCalculator(CCLAutoRepr):
             prof2 = prof
         self._check_mass_def(prof, prof2)
         self._get_ingredients(cosmo, a, get_bf=True)
+        if diag is not True:
+            # Integrate <u_2(k)><u_1(k')> without the (N_M, N_k, N_k) array.
+            k_use = np.atleast_1d(k).astype(float)
+            uk1, uk2 = prof_2pt.fourier_2pt_factors(
+                cosmo, k_use, self._mass, a, prof, prof2=prof2)
+            i12 = self._integrate_outer_over_mf(uk2.T, uk1.T, get_bf=True)
+            if np.ndim(k) == 0:
+                return i12[0, 0]
+            return i12
+
         uk = prof_2pt.fourier_2pt(cosmo, k, self._mass, a, prof,
-                                  prof2=prof2, diag=diag)
-        if diag is True:
-            uk = uk.T
-        else:
-            uk = np.transpose(uk, axes=[1, 2, 0])
+                                  prof2=prof2).T
         i12 = self._integrate_over_mbf(uk)
         return i12
 
@@ -441,4 +553,6 @@ class HMCalculator(CCLAutoRepr):
             uk34 = prof34_2pt.fourier_2pt(
                 cosmo, k, self._mass, a, prof3, prof2=prof4).T
 
-        return self._integrate_over_mf(uk12[None, :, :] * uk34[:, None, :])
+        if np.ndim(uk12) == 1:
+            return self._integrate_over_mf(uk12 * uk34)
+        return self._integrate_outer_over_mf(uk34, uk12, get_bf=False)
@@ -9,6 +9,14 @@ from .. import CCLAutoRepr, CCLNamedClass, lib, check
 from .. import physical_constants as const
 
 
+delta_c_types = {
+    'EdS': lib.delta_c_EdS,
+    'EdS_approx': lib.delta_c_EdS_approx,
+    'NakamuraSuto97': lib.delta_c_NakamuraSuto97,
+    'Mead16': lib.delta_c_Mead16,
+}
+
+
 def get_delta_c(cosmo, a, kind='EdS'):
     """Returns the linear collapse threshold.
 
@@ -33,18 +41,25 @@ def get_delta_c(cosmo, a, kind='EdS'):
         return dc0
     elif kind == 'EdS_approx':
         return 1.686
-    elif kind == 'NakamuraSuto97':
-        Om = cosmo.omega_x(a, 'matter')
-        return dc0*(1+0.012299*np.log10(Om))
-    elif kind == 'Mead16':
-        Om = cosmo.omega_x(a, 'matter')
-        s8 = cosmo.sigma8()*cosmo.growth_factor(a)
-        facs8 = (1.59+0.0314*np.log(s8))
-        facOm = (1+0.0123*np.log10(Om))
-        return facs8*facOm
-    else:
+    elif kind not in delta_c_types:
         raise ValueError(f"Unknown threshold kind {kind}")
 
+    # Omega_M(a) comes from the tabulated halo model background.
+    cosmo.compute_halo_background()
+    sigma8 = 0.
+    if kind == 'Mead16':
+        cosmo.compute_growth()
+        sigma8 = cosmo.sigma8()
+
+    a_use = np.atleast_1d(a).astype(float)
+    status = 0
+    dc, status = lib.delta_c_vec(cosmo.cosmo, delta_c_types[kind], sigma8,
+                                 a_use, a_use.size, status)
+    check(status, cosmo=cosmo)
+    if np.ndim(a) == 0:
+        return dc[0]
+    return dc.reshape(np.shape(a))
+
 
 class HMIngredients(CCLAutoRepr, CCLNamedClass):
     """Base class for halo model ingredients."""
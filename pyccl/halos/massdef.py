@@ -5,8 +5,10 @@ __all__ = ("mass2radius_lagrangian", "convert_concentration", "MassDef",
 from functools import cached_property
 
 import numpy as np
+from scipy.interpolate import RectBivariateSpline
 
 from .. import CCLAutoRepr, CCLNamedClass, lib, check
+from ..background import species_types
 from . import Concentration, HaloBias, MassFunc
 
 
@@ -133,13 +135,16 @@ class MassDef(CCLAutoRepr, CCLNamedClass):
         Returns:
             :obj:`float`: value of the virial overdensity.
         """
-        Omz = cosmo.omega_x(a, 'matter')
-        x = Omz-1
-        # Eq. 6
-        Dv = 18*np.pi**2+82*x-39*x**2
-        if self.rho_type == 'matter':
-            Dv /= Omz
-        return Dv
+        cosmo.compute_halo_background()
+        label = species_types[self.rho_type]
+        a_use = np.atleast_1d(a).astype(float)
+        status = 0
+        Dv, status = lib.Delta_vir_vec(cosmo.cosmo, label, a_use,
+                                       a_use.size, status)
+        check(status, cosmo=cosmo)
+        if np.ndim(a) == 0:
+            return Dv[0]
+        return Dv.reshape(np.shape(a))
 
     def get_Delta(self, cosmo, a):
         """ Gets overdensity parameter associated to this mass
@@ -325,6 +330,13 @@ def mass_translator(*, mass_in, mass_out, concentration):
     Returns a function that can be used to translate between halo
     masses according to two different definitions.
 
+    The translation is tabulated over masses and scale factors the first
+    time it is needed for a given cosmology and concentration, and
+    interpolated afterwards. Translated masses are therefore accurate to
+    about :math:`10^{-4}` rather than exact. The table is rebuilt if the
+    cosmology or the concentration-mass relation change, and is extended
+    whenever a call requests masses or scale factors outside its range.
+
     Args:
         mass_in (:class:`MassDef` or :obj:`str`): mass definition of the
             input mass.
@@ -338,7 +350,9 @@ def mass_translator(*, mass_in, mass_out, concentration):
         Function that ranslates between two masses. The returned function
         ``f`` can be called as: ``f(cosmo, M, a)``, where
         ``cosmo`` is a :class:`~pyccl.cosmology.Cosmology` object, ``M``
-        is a mass (or array of masses), and ``a`` is a scale factor.
+        is a mass (or array of masses), and ``a`` is a scale factor. If
+        called as ``f(cosmo, M, a, jacobian=True)``, it also returns the
+        Jacobian :math:`d\\log M_{\\rm out}/d\\log M_{\\rm in}`.
 
     """ # noqa
 
@@ -349,20 +363,72 @@ def mass_translator(*, mass_in, mass_out, concentration):
     if concentration.mass_def != mass_in:
         raise ValueError("mass_def of concentration doesn't match mass_in")
 
-    def translate(cosmo, M, a):
+    table = {"cosmo": None, "concentration": None}
+
+    def get_table(cosmo, lM, a):
+        # Interpolators of log(M_out/M_in) and of the Jacobian in
+        # (a, log M_in). Mass nodes sit at multiples of the LOGM_SPLINE
+        # spacing, so that extending the table keeps the existing ones.
+        spl = cosmo.cosmo.spline_params
+        dlM = np.log(10) * ((spl.LOGM_SPLINE_MAX - spl.LOGM_SPLINE_MIN) /
+                            (spl.LOGM_SPLINE_NM - 1))
+        i_lo = int(np.floor(np.min(lM) / dlM)) - 2
+        i_hi = int(np.ceil(np.max(lM) / dlM)) + 2
+        a_lo, a_hi = np.min(a), np.max(a)
+        # The concentration is hashed so that changes to its parameters
+        # also invalidate the table.
+        if ((table["cosmo"] == cosmo) and
+                (table["concentration"] == hash(concentration))):
+            if ((i_lo >= table["i_lo"]) and (i_hi <= table["i_hi"]) and
+                    (a_lo >= table["a_lo"]) and (a_hi <= table["a_hi"])):
+                return table["dlM"], table["jac"]
+            i_lo, i_hi = min(i_lo, table["i_lo"]), max(i_hi, table["i_hi"])
+            a_lo, a_hi = min(a_lo, table["a_lo"]), max(a_hi, table["a_hi"])
+
+        a_arr = cosmo.get_pk_spline_a()
+        if a_lo < a_arr[0]:
+            na = max(2, int(np.ceil(10 * np.log10(a_arr[0] / a_lo))) + 1)
+            a_arr = np.concatenate([np.geomspace(a_lo, a_arr[0], na)[:-1],
+                                    a_arr])
+        if a_hi > a_arr[-1]:
+            a_arr = np.concatenate([a_arr,
+                                    np.linspace(a_arr[-1], a_hi, 3)[1:]])
+        lM_arr = dlM * np.arange(i_lo, i_hi + 1)
+        M_arr = np.exp(lM_arr)
+
+        c_in = np.array([concentration(cosmo, M_arr, aa) for aa in a_arr])
+        D_in = mass_in.get_Delta(cosmo, a_arr) * cosmo.omega_x(
+            a_arr, mass_in.rho_type)
+        D_out = mass_out.get_Delta(cosmo, a_arr) * cosmo.omega_x(
+            a_arr, mass_out.rho_type)
+
+        status = 0
+        out, status = lib.mass_translation_table_vec(
+            cosmo.cosmo, D_in / D_out, lM_arr, c_in.flatten(),
+            2 * c_in.size, status)
+        check(status, cosmo=cosmo)
+        lM_out, jac = out.reshape([2, len(a_arr), len(lM_arr)])
+
+        table.update(cosmo=cosmo, concentration=hash(concentration),
+                     i_lo=i_lo, i_hi=i_hi,
+                     a_lo=a_arr[0], a_hi=a_arr[-1],
+                     dlM=RectBivariateSpline(a_arr, lM_arr,
+                                             lM_out - lM_arr[None, :]),
+                     jac=RectBivariateSpline(a_arr, lM_arr, jac))
+        return table["dlM"], table["jac"]
+
+    def translate(cosmo, M, a, *, jacobian=False):
         if mass_in == mass_out:
+            if jacobian:
+                return M, np.ones_like(M, dtype=float)
             return M
 
-        c_in = concentration(cosmo, M, a)
-        Om_in = cosmo.omega_x(a, mass_in.rho_type)
-        D_in = mass_in.get_Delta(cosmo, a) * Om_in
-        R_in = mass_in.get_radius(cosmo, M, a)
-
-        Om_out = cosmo.omega_x(a, mass_out.rho_type)
-        D_out = mass_out.get_Delta(cosmo, a) * Om_out
-        c_out = convert_concentration(
-            cosmo, c_old=c_in, Delta_old=D_in, Delta_new=D_out)
-        R_out = R_in * c_out/c_in
-        return mass_out.get_mass(cosmo, R_out, a)
+        lM = np.log(np.atleast_1d(M)).flatten()
+        a_use = np.full_like(lM, a)
+        dlM, jac = get_table(cosmo, lM, a_use)
+        M_out = np.exp(lM + dlM.ev(a_use, lM)).reshape(np.shape(M))
+        if not jacobian:
+            return M_out[()]
+        return M_out[()], jac.ev(a_use, lM).reshape(np.shape(M))[()]
 
     return translate
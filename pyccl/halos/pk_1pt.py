@@ -2,6 +2,8 @@ __all__ = ("halomod_mean_profile_1pt", "halomod_bias_1pt",)
 
 import numpy as np
 
+from . import HaloProfileHOD
+
 
 def _Ix1(func, cosmo, hmc, k, a, prof):
     # I_X_1 dispatcher for internal use
@@ -23,18 +25,22 @@ def _Ix1(func, cosmo, hmc, k, a, prof):
         ``k`` and ``a`` respectively. If ``k`` or ``a`` are scalars, the
         corresponding dimension will be squeezed out on output.
     """
-    func = getattr(hmc, func)
-
     a_use = np.atleast_1d(a).astype(float)
     k_use = np.atleast_1d(k).astype(float)
 
-    na = len(a_use)
-    nk = len(k_use)
-    out = np.zeros([na, nk])
-    for ia, aa in enumerate(a_use):
-        i11 = func(cosmo, k_use, aa, prof)
-        norm = prof.get_normalization(cosmo, aa, hmc=hmc)
-        out[ia] = i11 / norm
+    if isinstance(prof, HaloProfileHOD) and prof._has_default_moments():
+        # HOD moments for all scale factors in one pass
+        name = {"I_0_1": "mean_profile", "I_1_1": "bias_profile"}[func]
+        out = prof.get_moments(cosmo, a_use, hmc=hmc, k=k_use)[name]
+    else:
+        func = getattr(hmc, func)
+        norm = prof.get_normalization_grid(cosmo, a_use, hmc=hmc)
+        na = len(a_use)
+        nk = len(k_use)
+        out = np.zeros([na, nk])
+        for ia, aa in enumerate(a_use):
+            i11 = func(cosmo, k_use, aa, prof)
+            out[ia] = i11 / norm[ia]
 
     if np.ndim(a) == 0:
         out = np.squeeze(out, axis=0)
@@ -1,9 +1,10 @@
-__all__ = ("halomod_power_spectrum", "halomod_Pk2D",)
+__all__ = ("halomod_power_spectrum", "halomod_Pk2D",
+           "halomod_power_spectrum_cib",)
 
 import numpy as np
 
 from .. import Pk2D
-from . import Profile2pt
+from . import Profile2pt, HaloProfileCIBShang12
 
 
 def halomod_power_spectrum(cosmo, hmc, k, a, prof, *,
@@ -96,17 +97,19 @@ def halomod_power_spectrum(cosmo, hmc, k, a, prof, *,
     pk2d = cosmo.parse_pk(p_of_k_a)
     extrap = cosmo if extrap_pk else None  # extrapolation rule for pk2d
 
+    # normalizations
+    norms1 = prof.get_normalization_grid(cosmo, a_use, hmc=hmc)
+    if prof2 == prof:
+        norms2 = norms1
+    else:
+        norms2 = prof2.get_normalization_grid(cosmo, a_use, hmc=hmc)
+
     na = len(a_use)
     nk = len(k_use)
     out = np.zeros([na, nk])
     for ia, aa in enumerate(a_use):
-        # normalizations
-        norm1 = prof.get_normalization(cosmo, aa, hmc=hmc)
-
-        if prof2 == prof:
-            norm2 = norm1
-        else:
-            norm2 = prof2.get_normalization(cosmo, aa, hmc=hmc)
+        norm1 = norms1[ia]
+        norm2 = norms2[ia]
 
         if get_2h:
             # bias factors
@@ -230,3 +233,90 @@ def halomod_Pk2D(cosmo, hmc, prof, *,
                 extrap_order_lok=extrap_order_lok,
                 extrap_order_hik=extrap_order_hik,
                 is_logp=False)
+
+
+def halomod_power_spectrum_cib(cosmo, hmc, k, a, prof, nu_GHz, *,
+                               p_of_k_a=None, get_1h=True, get_2h=True,
+                               extrap_pk=False):
+    """ Computes the halo model CIB power spectra between all pairs
+    of a set of frequencies. The result for each pair of frequencies
+    :math:`(\\nu,\\nu')` is the same as that of
+    :meth:`halomod_power_spectrum` with two
+    :class:`~pyccl.halos.profiles.cib_shang12.HaloProfileCIBShang12`
+    profiles at those frequencies and a
+    :class:`~pyccl.halos.profiles_2pt.Profile2ptCIB` two-point moment.
+    However, the luminosity-mass relation, subhalo integral and
+    satellite profile are evaluated only once for all frequencies
+    (see
+    :meth:`~pyccl.halos.profiles.cib_shang12.HaloProfileCIBShang12.fourier_multifreq`).
+
+    Args:
+        cosmo (:class:`~pyccl.cosmology.Cosmology`): a Cosmology object.
+        hmc (:class:`~pyccl.halos.halo_model.HMCalculator`): a halo model calculator.
+        k (:obj:`float` or `array`): comoving wavenumber in Mpc^-1.
+        a (:obj:`float` or `array`): scale factor.
+        prof (:class:`~pyccl.halos.profiles.cib_shang12.HaloProfileCIBShang12`):
+            CIB halo profile. Its own frequency is ignored.
+        nu_GHz (:obj:`float` or `array`): frequencies in GHz.
+        p_of_k_a (:class:`~pyccl.pk2d.Pk2D`): a `Pk2D` object to
+            be used as the linear matter power spectrum. If ``None``,
+            the power spectrum stored within `cosmo` will be used.
+        get_1h (:obj:`bool`): if ``False``, the 1-halo term won't be
+            computed.
+        get_2h (:obj:`bool`): if ``False``, the 2-halo term won't be
+            computed.
+        extrap_pk (:obj:`bool`):
+            Whether to extrapolate ``p_of_k_a`` in case ``a`` is out of its
+            support. If ```False```, and the queried values are out of bounds,
+            an error is raised.
+
+    Returns:
+        (:obj:`float` or `array`): power spectra evaluated at each
+        combination of frequencies, ``k`` and ``a``. The shape of the
+        output will be ``(N_nu, N_nu, N_a, N_k)`` where ``N_nu``,
+        ``N_a`` and ``N_k`` are the sizes of ``nu_GHz``, ``a`` and ``k``
+        respectively. Dimensions corresponding to scalar inputs are
+        squeezed out on output.
+    """ # noqa
+    if not isinstance(prof, HaloProfileCIBShang12):
+        raise TypeError("prof must be HaloProfileCIBShang12")
+
+    a_use = np.atleast_1d(a).astype(float)
+    k_use = np.atleast_1d(k).astype(float)
+    nu_use = np.atleast_1d(nu_GHz).astype(float)
+
+    pk2d = cosmo.parse_pk(p_of_k_a)
+    extrap = cosmo if extrap_pk else None  # extrapolation rule for pk2d
+
+    hmc._check_mass_def(prof)
+    M = hmc._mass
+    nnu = len(nu_use)
+    nk = len(k_use)
+    out = np.zeros([nnu, nnu, len(a_use), nk])
+    for ia, aa in enumerate(a_use):
+        norm = prof.get_normalization(cosmo, aa, hmc=hmc)
+        hmc._get_ingredients(cosmo, aa, get_bf=get_2h)
+
+        # The mass integrals take 2D arrays with the mass axis last.
+        if get_2h:
+            uk = prof.fourier_multifreq(cosmo, k_use, M, aa, nu_use)
+            uk = np.transpose(uk, axes=(0, 2, 1)).reshape([-1, len(M)])
+            i11 = hmc._integrate_over_mbf(uk).reshape([nnu, nk])
+            pk = pk2d(k_use, aa, cosmo=extrap)
+            out[:, :, ia] += pk * i11[:, None, :] * i11[None, :, :]
+
+        if get_1h:
+            uk2 = prof.fourier_variance_multifreq(cosmo, k_use, M, aa, nu_use)
+            uk2 = np.transpose(uk2, axes=(0, 1, 3, 2)).reshape([-1, len(M)])
+            out[:, :, ia] += hmc._integrate_over_mf(uk2).reshape(
+                [nnu, nnu, nk])
+
+        out[:, :, ia] /= norm**2
+
+    if np.ndim(k) == 0:
+        out = np.squeeze(out, axis=-1)
+    if np.ndim(a) == 0:
+        out = np.squeeze(out, axis=2)
+    if np.ndim(nu_GHz) == 0:
+        out = np.squeeze(out, axis=(0, 1))
+    return out
@@ -1,12 +1,53 @@
 __all__ = ("HaloProfileCIBShang12",)
 
+import functools
+
 import numpy as np
 from scipy.integrate import simpson
+from scipy.interpolate import interp1d
 from scipy.special import lambertw
 
 from . import HaloProfileNFW, HaloProfileCIB
 
 
+# Upper edge of the parent mass grid of the satellite luminosity table,
+# and its sampling (points per decade in mass, for parent and subhalos).
+LOGM_MAX_LUMSAT = 17.
+NM_PER_DECADE_LUMSAT = 20
+NMSUB_PER_DECADE_LUMSAT = 10
+
+
+def _dNsub_dlnM_TinkerWetzel10(Msub, Mparent):
+    return 0.30*(Msub/Mparent)**(-0.7)*np.exp(-9.9*(Msub/Mparent)**2.5)
+
+
+def _sigma_LM(l10M, log10Meff, siglog10M):
+    # Lognormal mass dependence of the galaxy luminosity,
+    # M/sqrt(2*pi*siglog10M^2) * exp(-log10^2(M/Meff)/(2*siglog10M^2)).
+    sig_pref = 10**l10M/(2.50662827463*siglog10M)
+    return sig_pref * np.exp(-0.5*((l10M - log10Meff) / siglog10M)**2)
+
+
+@functools.lru_cache(maxsize=32)
+def _lumsat_table(dNsub_dlnM, log10Meff, siglog10M, log10Mmin, log10Mmax):
+    # Satellite luminosity per unit L0 at a=1 as a function of the
+    # parent mass, L_sat(M) = int_Mmin^M dlnm dN_sub/dlnm Sigma(m),
+    # for the subhalo mass function dNsub_dlnM(Msub, Mparent).
+    # Written as L_sat = log10(M/Mmin) * H(M), where H is smooth and
+    # positive, and log(H) is interpolated.
+    nM = int(np.ceil(NM_PER_DECADE_LUMSAT*(log10Mmax-log10Mmin)))+1
+    nsub = int(np.ceil(NMSUB_PER_DECADE_LUMSAT*(log10Mmax-log10Mmin)))+1
+    lM = np.linspace(log10Mmin, log10Mmax, nM)
+    t = np.linspace(0, 1, nsub)
+    # Each parent mass gets its own subhalo grid between Mmin and M.
+    lmsub = log10Mmin + (lM-log10Mmin)[:, None]*t[None, :]
+    integ = (dNsub_dlnM(10**lmsub, 10**lM[:, None]) *
+             _sigma_LM(lmsub, log10Meff, siglog10M))
+    H = simpson(integ, x=np.log(10)*t, axis=-1)
+    lH = np.log(np.maximum(H, np.finfo(float).tiny))
+    return interp1d(lM, lH, kind='cubic')
+
+
 class HaloProfileCIBShang12(HaloProfileCIB):
     """ CIB profile implementing the model by `Shang et al. 2012
     <https://arxiv.org/abs/1109.1522>`_.
@@ -115,7 +156,7 @@ class HaloProfileCIBShang12(HaloProfileCIB):
         Returns:
             (:obj:`float` or `array`): average number of subhalos.
         """
-        return 0.30*(Msub/Mparent)**(-0.7)*np.exp(-9.9*(Msub/Mparent)**2.5)
+        return _dNsub_dlnM_TinkerWetzel10(Msub, Mparent)
 
     def update_parameters(self, nu_GHz=None,
                           alpha=None, T0=None, beta=None, gamma=None,
@@ -185,10 +226,7 @@ class HaloProfileCIBShang12(HaloProfileCIB):
         # Redshift evolution
         phi_z = a**(-self.s_z)
         # Mass dependence
-        # M/sqrt(2*pi*siglog10M^2)
-        sig_pref = 10**l10M/(2.50662827463*self.siglog10M)
-        sigma_m = sig_pref * np.exp(-0.5*((l10M - self.log10Meff)
-                                          / self.siglog10M)**2)
+        sigma_m = _sigma_LM(l10M, self.log10Meff, self.siglog10M)
         return self.L0*phi_z*sigma_m
 
     def _Lumcen(self, M, a):
@@ -197,21 +235,28 @@ class HaloProfileCIBShang12(HaloProfileCIB):
         return Lumcen
 
     def _Lumsat(self, M, a):
-        if not np.max(M) > self.Mmin:
-            return np.zeros_like(M)
-
-        res = np.zeros_like(M)
-        M_use = M[M >= self.Mmin, None]
-        logM = np.log10(M_use)
-        LOGM_MIN = np.log10(self.Mmin)
-        nm = max(2, 10*int(np.max(logM) - LOGM_MIN))
-        msub = np.linspace(LOGM_MIN, np.max(logM), nm+1)[None, :]
-
-        Lum = self._Lum(msub, a)
-        dnsubdlnm = self.dNsub_dlnM_TinkerWetzel10(10**msub, M_use)
-        integ = dnsubdlnm * Lum
-        Lumsat = simpson(integ, x=np.log(10)*msub)
-        res[-len(Lumsat):] = Lumsat
+        # Interpolated from a table of the subhalo mass integral, which
+        # only depends on the luminosity-mass relation and Mmin. The
+        # redshift dependence of the luminosity factors out.
+        res = np.zeros_like(M, dtype=float)
+        good = M > self.Mmin
+        if not np.any(good):
+            return res
+
+        l10Mmin = np.log10(self.Mmin)
+        l10M = np.log10(M[good])
+        l10Mmax = max(LOGM_MAX_LUMSAT, np.ceil(np.max(l10M)), l10Mmin+1)
+        dNsub = self.dNsub_dlnM_TinkerWetzel10
+        if (type(self).dNsub_dlnM_TinkerWetzel10 is
+                HaloProfileCIBShang12.dNsub_dlnM_TinkerWetzel10):
+            # Share the table between all profiles using the default
+            # subhalo mass function.
+            dNsub = _dNsub_dlnM_TinkerWetzel10
+        lH = _lumsat_table(dNsub,
+                           float(self.log10Meff), float(self.siglog10M),
+                           float(l10Mmin), float(l10Mmax))
+        res[good] = (self.L0*a**(-self.s_z) *
+                     (l10M-l10Mmin)*np.exp(lH(l10M)))
         return res
 
     def _real(self, cosmo, r, M, a):
@@ -232,6 +277,15 @@ class HaloProfileCIBShang12(HaloProfileCIB):
             prof = np.squeeze(prof, axis=0)
         return prof
 
+    def _fourier_lum(self, cosmo, k, M, a):
+        # Frequency-independent ingredients of the Fourier profile:
+        # central and satellite luminosities, and the normalized
+        # satellite profile.
+        Lc = self._Lumcen(M, a)
+        Ls = self._Lumsat(M, a)
+        uk = self.pNFW._fourier(cosmo, k, M, a)/M[:, None]
+        return Lc, Ls, uk
+
     def _fourier(self, cosmo, k, M, a):
         M_use = np.atleast_1d(M)
         k_use = np.atleast_1d(k)
@@ -239,9 +293,7 @@ class HaloProfileCIBShang12(HaloProfileCIB):
         # (redshifted) Frequency dependence
         spec_nu = self._spectrum(self.nu/a, a)
 
-        Lc = self._Lumcen(M_use, a)
-        Ls = self._Lumsat(M_use, a)
-        uk = self.pNFW._fourier(cosmo, k_use, M_use, a)/M_use[:, None]
+        Lc, Ls, uk = self._fourier_lum(cosmo, k_use, M_use, a)
 
         prof = (Lc[:, None]+Ls[:, None]*uk)*spec_nu*self._one_over_4pi
 
@@ -261,9 +313,7 @@ class HaloProfileCIBShang12(HaloProfileCIB):
         else:
             spec_nu2 = self._spectrum(nu_other/a, a)
 
-        Lc = self._Lumcen(M_use, a)
-        Ls = self._Lumsat(M_use, a)
-        uk = self.pNFW._fourier(cosmo, k_use, M_use, a)/M_use[:, None]
+        Lc, Ls, uk = self._fourier_lum(cosmo, k_use, M_use, a)
 
         prof = Ls[:, None]*uk
         prof = 2*Lc[:, None]*prof + prof**2
@@ -274,3 +324,83 @@ class HaloProfileCIBShang12(HaloProfileCIB):
         if np.ndim(M) == 0:
             prof = np.squeeze(prof, axis=0)
         return prof
+
+    def fourier_multifreq(self, cosmo, k, M, a, nu_GHz):
+        """ Returns the Fourier-space profile at several frequencies.
+        The mass- and scale-dependent parts of the profile are
+        computed only once, so this is equivalent to, but faster
+        than, calling :meth:`fourier` with one profile per frequency.
+
+        Args:
+            cosmo (:class:`~pyccl.cosmology.Cosmology`): a Cosmology object.
+            k (:obj:`float` or `array`): comoving wavenumber in Mpc^-1.
+            M (:obj:`float` or `array`): halo mass in units of M_sun.
+            a (:obj:`float`): scale factor.
+            nu_GHz (:obj:`float` or `array`): frequencies in GHz.
+
+        Returns:
+            (:obj:`float` or `array`): Fourier-space profile. The shape of
+            the output will be ``(N_nu, N_M, N_k)``, where ``N_nu``,
+            ``N_M`` and ``N_k`` are the sizes of ``nu_GHz``, ``M`` and
+            ``k`` respectively. Dimensions corresponding to scalar inputs
+            are squeezed out on output.
+        """
+        M_use = np.atleast_1d(M)
+        k_use = np.atleast_1d(k)
+        nu_use = np.atleast_1d(nu_GHz).astype(float)
+
+        spec_nu = self._spectrum(nu_use/a, a)
+
+        Lc, Ls, uk = self._fourier_lum(cosmo, k_use, M_use, a)
+
+        prof = (Lc[:, None]+Ls[:, None]*uk)*self._one_over_4pi
+        prof = spec_nu[:, None, None]*prof[None, :, :]
+
+        if np.ndim(k) == 0:
+            prof = np.squeeze(prof, axis=-1)
+        if np.ndim(M) == 0:
+            prof = np.squeeze(prof, axis=1)
+        if np.ndim(nu_GHz) == 0:
+            prof = np.squeeze(prof, axis=0)
+        return prof
+
+    def fourier_variance_multifreq(self, cosmo, k, M, a, nu_GHz):
+        """ Returns the Fourier-space one-halo two-point moment
+        (see :class:`~pyccl.halos.profiles_2pt.Profile2ptCIB`) for all
+        pairs of frequencies, computing the mass- and scale-dependent
+        parts only once.
+
+        Args:
+            cosmo (:class:`~pyccl.cosmology.Cosmology`): a Cosmology object.
+            k (:obj:`float` or `array`): comoving wavenumber in Mpc^-1.
+            M (:obj:`float` or `array`): halo mass in units of M_sun.
+            a (:obj:`float`): scale factor.
+            nu_GHz (:obj:`float` or `array`): frequencies in GHz.
+
+        Returns:
+            (:obj:`float` or `array`): second-order Fourier-space moment.
+            The shape of the output will be ``(N_nu, N_nu, N_M, N_k)``,
+            where ``N_nu``, ``N_M`` and ``N_k`` are the sizes of
+            ``nu_GHz``, ``M`` and ``k`` respectively. Dimensions
+            corresponding to scalar inputs are squeezed out on output.
+        """
+        M_use = np.atleast_1d(M)
+        k_use = np.atleast_1d(k)
+        nu_use = np.atleast_1d(nu_GHz).astype(float)
+
+        spec_nu = self._spectrum(nu_use/a, a)
+
+        Lc, Ls, uk = self._fourier_lum(cosmo, k_use, M_use, a)
+
+        prof = Ls[:, None]*uk
+        prof = (2*Lc[:, None]*prof + prof**2)*self._one_over_4pi**2
+        prof = (spec_nu[:, None, None, None]*spec_nu[None, :, None, None] *
+                prof[None, None, :, :])
+
+        if np.ndim(k) == 0:
+            prof = np.squeeze(prof, axis=-1)
+        if np.ndim(M) == 0:
+            prof = np.squeeze(prof, axis=2)
+        if np.ndim(nu_GHz) == 0:
+            prof = np.squeeze(prof, axis=(0, 1))
+        return prof
@@ -1,13 +1,60 @@
 __all__ = ("HaloProfileEinasto",)
 
+import functools
+
 import numpy as np
 from scipy.integrate import quad_vec
+from scipy.interpolate import RectBivariateSpline, interp1d
 from scipy.special import gamma, gammainc
 
+from ... import check, lib
 from .. import MassDef, mass_translator, get_delta_c
 from . import HaloProfileMatter
 
 
+# Ranges (log10) and sampling (points per decade) of the dimensionless
+# Einasto templates in q = k r_s and X = R / r_s, and spacing of their
+# grid in alpha.
+LQ_MIN_EINASTO, LQ_MAX_EINASTO = -4., 4.
+LX_MIN_EINASTO, LX_MAX_EINASTO = -4., 3.
+N_PER_DECADE_EINASTO = 64
+DALPHA_EINASTO = 0.01
+
+
+@functools.lru_cache(maxsize=8)
+def _einasto_tables(alphas, padding_lo, padding_hi, n_per_decade):
+    # Fourier-space template F(q) = int dx x^2 e(x) j_0(qx) and projected
+    # template S(X) = 2 int dz e(sqrt(z^2+X^2)), with
+    # e(x) = exp(-2 (x^alpha-1)/alpha), computed in C through FFTLog for
+    # all alphas, and their interpolators in (alpha, log10(q or X)).
+    alpha_arr = np.array(alphas)
+    lq = np.linspace(LQ_MIN_EINASTO, LQ_MAX_EINASTO,
+                     int((LQ_MAX_EINASTO-LQ_MIN_EINASTO) *
+                         N_PER_DECADE_EINASTO)+1)
+    lx = np.linspace(LX_MIN_EINASTO, LX_MAX_EINASTO,
+                     int((LX_MAX_EINASTO-LX_MIN_EINASTO) *
+                         N_PER_DECADE_EINASTO)+1)
+    na, nq, nx = len(alpha_arr), len(lq), len(lx)
+
+    status = 0
+    out, status = lib.einasto_tables_vec(
+        alpha_arr, padding_lo, padding_hi, n_per_decade,
+        10**lq, 10**lx, na*(nq+nx), status)
+    check(status)
+    fq = out[:na*nq].reshape([na, nq])
+    sx = out[na*nq:].reshape([na, nx])
+
+    def get_interp(lgrid, table):
+        if na == 1:
+            f = interp1d(lgrid, table[0], kind='cubic')
+            return lambda alpha, lv: f(lv)
+        spl = RectBivariateSpline(alpha_arr, lgrid, table,
+                                  kx=min(3, na-1), ky=3)
+        return lambda alpha, lv: spl.ev(alpha, lv)
+
+    return get_interp(lq, fq), get_interp(lx, sx)
+
+
 class HaloProfileEinasto(HaloProfileMatter):
     """ `Einasto 1965
     <https://ui.adsabs.harvard.edu/abs/1965TrAlm...5...87E/abstract>`_
@@ -48,6 +95,10 @@ class HaloProfileEinasto(HaloProfileMatter):
             projected profile with numerical integration.
         alpha (:obj:`float` or :obj:`str`): :math:`\\alpha` parameter, or
             set to ``'cosmo'`` to calculate the value from cosmology.
+
+    For untruncated profiles, the Fourier-space and projected profiles are
+    interpolated from dimensionless templates in :math:`k\\,r_s` (or
+    :math:`R/r_s`) and :math:`\\alpha`, computed once with FFTLog.
     """
     __repr_attrs__ = __eq_attrs__ = (
         "truncated", "alpha", "projected_quad",
@@ -66,6 +117,10 @@ class HaloProfileEinasto(HaloProfileMatter):
                                  "for truncated Einasto. Set `truncated` or "
                                  "`projected_quad` to `False`.")
             self._projected = self._projected_quad
+        if not truncated:
+            self._fourier = self._fourier_table
+            if not projected_quad:
+                self._projected = self._projected_table
         super().__init__(mass_def=mass_def, concentration=concentration)
         self._to_virial_mass = mass_translator(
             mass_in=self.mass_def, mass_out=MassDef("vir", "matter"),
@@ -151,3 +206,72 @@ class HaloProfileEinasto(HaloProfileMatter):
     def _projected_quad_integrand(self, z, R, R_s, alpha):
         x = np.sqrt(z**2. + R**2.) / R_s
         return np.exp(-2. * (x**alpha - 1.) / alpha)
+
+    def _get_tables(self, alpha):
+        # Template interpolators covering all values of alpha.
+        if self.alpha == 'cosmo':
+            # Fixed grid, extended only for unusual values, so the
+            # same tables are reused for all masses and redshifts.
+            lo = min(0.1, np.min(alpha))
+            hi = max(0.6, np.ceil(np.max(alpha)*10)/10)
+            n = int(np.ceil((hi-lo)/DALPHA_EINASTO))+1
+            alphas = tuple(np.linspace(lo, hi, n))
+        else:
+            alphas = (float(self.alpha),)
+        return _einasto_tables(alphas,
+                               self.precision_fftlog['padding_lo_fftlog'],
+                               self.precision_fftlog['padding_hi_fftlog'],
+                               self.precision_fftlog['n_per_decade'])
+
+    def _fourier_table(self, cosmo, k, M, a):
+        M_use = np.atleast_1d(M)
+        k_use = np.atleast_1d(k)
+
+        # Comoving virial radius
+        R_M = self.mass_def.get_radius(cosmo, M_use, a) / a
+        c_M = self.concentration(cosmo, M_use, a)
+        R_s = R_M / c_M
+
+        alpha = self._get_alpha(cosmo, M_use, a)
+        fq, _ = self._get_tables(alpha)
+
+        lq = np.log10(k_use[None, :] * R_s[:, None])
+        alpha_b = np.broadcast_to(alpha[:, None], lq.shape)
+        norm = 4 * np.pi * R_s**3 * self._norm(M_use, R_s, c_M, alpha)
+        prof = norm[:, None] * fq(alpha_b, np.clip(lq, LQ_MIN_EINASTO,
+                                                   LQ_MAX_EINASTO))
+        # The template is constant at small q, and decays as q^(-3-alpha)
+        # (set by the x^alpha cusp of the profile) at large q.
+        prof *= 10**((-3-alpha_b) * np.clip(lq-LQ_MAX_EINASTO, 0, None))
+
+        if np.ndim(k) == 0:
+            prof = np.squeeze(prof, axis=-1)
+        if np.ndim(M) == 0:
+            prof = np.squeeze(prof, axis=0)
+        return prof
+
+    def _projected_table(self, cosmo, r, M, a):
+        r_use = np.atleast_1d(r)
+        M_use = np.atleast_1d(M)
+
+        # Comoving virial radius
+        R_M = self.mass_def.get_radius(cosmo, M_use, a) / a
+        c_M = self.concentration(cosmo, M_use, a)
+        R_s = R_M / c_M
+
+        alpha = self._get_alpha(cosmo, M_use, a)
+        _, sx = self._get_tables(alpha)
+
+        lx = np.log10(r_use[None, :] / R_s[:, None])
+        alpha_b = np.broadcast_to(alpha[:, None], lx.shape)
+        norm = R_s * self._norm(M_use, R_s, c_M, alpha)
+        prof = norm[:, None] * sx(alpha_b, np.clip(lx, LX_MIN_EINASTO,
+                                                   LX_MAX_EINASTO))
+        # The profile is negligible beyond the range of the template.
+        prof[lx > LX_MAX_EINASTO] = 0
+
+        if np.ndim(r) == 0:
+            prof = np.squeeze(prof, axis=-1)
+        if np.ndim(M) == 0:
+            prof = np.squeeze(prof, axis=0)
+        return prof
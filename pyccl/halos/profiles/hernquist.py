@@ -1,8 +1,8 @@
 __all__ = ("HaloProfileHernquist",)
 
 import numpy as np
-from scipy.special import sici
 
+from ... import check, lib
 from . import HaloProfileMatter
 
 
@@ -78,25 +78,23 @@ class HaloProfileHernquist(HaloProfileMatter):
                                      n_per_decade=1000,
                                      plaw_fourier=-2.)
 
-    def _norm(self, M, Rs, c):
-        # Hernquist normalization from mass, radius and concentration
-        return M / (2 * np.pi * Rs**3 * (c / (1 + c))**2)
-
-    def _real(self, cosmo, r, M, a):
-        r_use = np.atleast_1d(r)
-        M_use = np.atleast_1d(M)
+    def _profile_c(self, kind, cosmo, r, M, a, truncated):
+        # Evaluates the requested profile for all masses and radii (or
+        # wavenumbers) in a single C call.
+        r_use = np.atleast_1d(r).astype(float)
+        M_use = np.atleast_1d(M).astype(float)
 
         # Comoving virial radius
         R_M = self.mass_def.get_radius(cosmo, M_use, a) / a
-        c_M = self.concentration(cosmo, M_use, a)
+        c_M = np.atleast_1d(self.concentration(cosmo, M_use, a))
         R_s = R_M / c_M
 
-        norm = self._norm(M_use, R_s, c_M)
-
-        x = r_use[None, :] / R_s[:, None]
-        prof = norm[:, None] / (x * (1 + x)**3)
-        if self.truncated:
-            prof[r_use[None, :] > R_M[:, None]] = 0
+        status = 0
+        prof, status = lib.hernquist_profile_vec(
+            kind, int(truncated), M_use, R_s, c_M.astype(float), r_use,
+            M_use.size * r_use.size, status)
+        check(status, cosmo=cosmo)
+        prof = prof.reshape([M_use.size, r_use.size])
 
         if np.ndim(r) == 0:
             prof = np.squeeze(prof, axis=-1)
@@ -104,112 +102,19 @@ class HaloProfileHernquist(HaloProfileMatter):
             prof = np.squeeze(prof, axis=0)
         return prof
 
-    def _fx_projected(self, x):
-
-        def f1(xx):
-            x2m1 = xx * xx - 1
-            sqx2m1 = np.sqrt(-x2m1)
-            return (-3 / 2 / x2m1**2
-                    + (x2m1+3) * np.arcsinh(sqx2m1 / xx) / 2 / (-x2m1)**2.5)
-
-        def f2(xx):
-            x2m1 = xx * xx - 1
-            sqx2m1 = np.sqrt(x2m1)
-            return (-3 / 2 / x2m1**2
-                    + (x2m1+3) * np.arcsin(sqx2m1 / xx) / 2 / x2m1**2.5)
-
-        xf = x.flatten()
-        return np.piecewise(xf,
-                            [xf < 1, xf > 1],
-                            [f1, f2, 2./15.]).reshape(x.shape)
+    def _real(self, cosmo, r, M, a):
+        return self._profile_c(lib.ccl_hernquist_real, cosmo, r, M, a,
+                               self.truncated)
 
     def _projected_analytic(self, cosmo, r, M, a):
-        r_use = np.atleast_1d(r)
-        M_use = np.atleast_1d(M)
-
-        # Comoving virial radius
-        R_M = self.mass_def.get_radius(cosmo, M_use, a) / a
-        c_M = self.concentration(cosmo, M_use, a)
-        R_s = R_M / c_M
-
-        x = r_use[None, :] / R_s[:, None]
-        prof = self._fx_projected(x)
-        norm = 2 * R_s * self._norm(M_use, R_s, c_M)
-        prof = prof[:, :] * norm[:, None]
-
-        if np.ndim(r) == 0:
-            prof = np.squeeze(prof, axis=-1)
-        if np.ndim(M) == 0:
-            prof = np.squeeze(prof, axis=0)
-        return prof
-
-    def _fx_cumul2d(self, x):
-
-        def f1(xx):
-            x2m1 = xx * xx - 1
-            sqx2m1 = np.sqrt(-x2m1)
-            return (1 + 1 / x2m1
-                    + (x2m1 + 1) * np.arcsinh(sqx2m1 / xx) / (-x2m1)**1.5)
-
-        def f2(xx):
-            x2m1 = xx * xx - 1
-            sqx2m1 = np.sqrt(x2m1)
-            return (1 + 1 / x2m1
-                    - (x2m1 + 1) * np.arcsin(sqx2m1 / xx) / x2m1**1.5)
-
-        xf = x.flatten()
-        f = np.piecewise(xf,
-                         [xf < 1, xf > 1],
-                         [f1, f2, 1./3.]).reshape(x.shape)
-
-        return f / x**2
+        # The analytic projected profile is never truncated.
+        return self._profile_c(lib.ccl_hernquist_projected, cosmo, r, M, a,
+                               False)
 
     def _cumul2d_analytic(self, cosmo, r, M, a):
-        r_use = np.atleast_1d(r)
-        M_use = np.atleast_1d(M)
-
-        # Comoving virial radius
-        R_M = self.mass_def.get_radius(cosmo, M_use, a) / a
-        c_M = self.concentration(cosmo, M_use, a)
-        R_s = R_M / c_M
-
-        x = r_use[None, :] / R_s[:, None]
-        prof = self._fx_cumul2d(x)
-        norm = 2 * R_s * self._norm(M_use, R_s, c_M)
-        prof = prof * norm[:, None]
-
-        if np.ndim(r) == 0:
-            prof = np.squeeze(prof, axis=-1)
-        if np.ndim(M) == 0:
-            prof = np.squeeze(prof, axis=0)
-        return prof
+        return self._profile_c(lib.ccl_hernquist_cumul2d, cosmo, r, M, a,
+                               False)
 
     def _fourier_analytic(self, cosmo, k, M, a):
-        M_use = np.atleast_1d(M)
-        k_use = np.atleast_1d(k)
-
-        # Comoving virial radius
-        R_M = self.mass_def.get_radius(cosmo, M_use, a) / a
-        c_M = self.concentration(cosmo, M_use, a)
-        R_s = R_M / c_M
-
-        x = k_use[None, :] * R_s[:, None]
-        Si2, Ci2 = sici(x)
-        P1 = M / ((c_M / (c_M + 1))**2 / 2)
-        c_Mp1 = c_M[:, None] + 1
-        if self.truncated:
-            Si1, Ci1 = sici(c_Mp1 * x)
-            P2 = x * np.sin(x) * (Ci1 - Ci2) - x * np.cos(x) * (Si1 - Si2)
-            P3 = (-1 + np.sin(c_M[:, None] * x) / (c_Mp1**2 * x)
-                  + c_Mp1 * np.cos(c_M[:, None] * x) / (c_Mp1**2))
-            prof = P1[:, None] * (P2 - P3) / 2
-        else:
-            P2 = (-x * (2 * np.sin(x) * Ci2 + np.pi * np.cos(x))
-                  + 2 * x * np.cos(x) * Si2 + 2) / 4
-            prof = P1[:, None] * P2
-
-        if np.ndim(k) == 0:
-            prof = np.squeeze(prof, axis=-1)
-        if np.ndim(M) == 0:
-            prof = np.squeeze(prof, axis=0)
-        return prof
+        return self._profile_c(lib.ccl_hernquist_fourier, cosmo, k, M, a,
+                               self.truncated)
@@ -333,14 +333,107 @@ class HaloProfileHOD(HaloProfile):
             :obj:`float`: normalization factor of this profile.
         """
         def integ(M):
-            Nc = self._Nc(M, a)
-            Ns = self._Ns(M, a)
-            fc = self._fc(a)
-            if self.ns_independent:
-                return Nc*fc + Ns
-            return Nc*(fc + Ns)
+            return self._Ntot(M, a)
         return hmc.integrate_over_massfunc(integ, cosmo, a)
 
+    def get_normalization_grid(self, cosmo, a, *, hmc):
+        """Returns the mean galaxy number density for a set of scale
+        factors, integrating the occupation numbers over the mass
+        function for all of them in one pass.
+
+        Args:
+            cosmo (:class:`~pyccl.cosmology.Cosmology`): a Cosmology
+                object.
+            a (:obj:`float` or `array`): scale factors.
+            hmc (:class:`~pyccl.halos.halo_model.HMCalculator`): a halo
+                model calculator object.
+
+        Returns:
+            (:obj:`float` or `array`): mean galaxy number density.
+        """
+        if not self._has_default_normalization():
+            # Respect subclasses that redefine the normalization
+            return super().get_normalization_grid(cosmo, a, hmc=hmc)
+        return hmc.integrate_over_massfunc_grid(self._Ntot, cosmo, a)
+
+    def _has_default_normalization(self):
+        # True if `get_normalization` is the mass integral of `_Ntot`.
+        return (type(self).get_normalization is
+                HaloProfileHOD.get_normalization)
+
+    def _has_default_moments(self):
+        # True if `get_moments` agrees with the one-point functions
+        # computed from `fourier` and `get_normalization`.
+        cls = type(self)
+        return (self._has_default_normalization() and
+                all(getattr(cls, name) is getattr(HaloProfileHOD, name)
+                    for name in ["_fourier", "_usat_fourier", "_usat_real"]))
+
+    def get_moments(self, cosmo, a, *, hmc, k=None):
+        """Returns the mean galaxy number density, the effective galaxy
+        bias and, optionally, the normalized one-point moments of the
+        profile for a set of scale factors. The occupation numbers are
+        evaluated on an ``(N_a, N_M)`` grid and integrated against
+        mass function and halo bias tables computed once for all scale
+        factors.
+
+        Args:
+            cosmo (:class:`~pyccl.cosmology.Cosmology`): a Cosmology
+                object.
+            a (:obj:`float` or `array`): scale factors.
+            hmc (:class:`~pyccl.halos.halo_model.HMCalculator`): a halo
+                model calculator object.
+            k (:obj:`float` or `array`): comoving wavenumbers in
+                :math:`{\\rm Mpc}^{-1}`. If ``None``, only the number
+                density and bias are computed.
+
+        Returns:
+            :obj:`dict`: dictionary with entries ``'n_g'`` (mean number
+            density), ``'b_eff'`` (effective bias, i.e. the bias-weighted
+            mean number of galaxies divided by ``'n_g'``) and, if ``k`` is
+            not ``None``, ``'mean_profile'`` and ``'bias_profile'``, equal to
+            :func:`~pyccl.halos.pk_1pt.halomod_mean_profile_1pt` and
+            :func:`~pyccl.halos.pk_1pt.halomod_bias_1pt` respectively,
+            with shape ``(N_a, N_k)``. Dimensions corresponding to scalar
+            inputs are squeezed out on output.
+        """
+        hmc._check_mass_def(self)
+        a_use = np.atleast_1d(a).astype(float)
+
+        ngal = hmc.integrate_over_massfunc_grid(self._Ntot, cosmo, a_use)
+        nbias = hmc.integrate_over_massfunc_grid(self._Ntot, cosmo, a_use,
+                                                 with_bias=True)
+        out = {"n_g": ngal, "b_eff": nbias / ngal}
+
+        if k is not None:
+            k_use = np.atleast_1d(k).astype(float)
+            M = hmc._mass
+            # Satellite profiles with shape (N_a, N_k, N_M)
+            uk = np.array([self._usat_fourier(cosmo, k_use, M, aa).T
+                           for aa in a_use])
+            Nc = self._Nc(M, a_use[:, None])[:, None, :]
+            Ns = self._Ns(M, a_use[:, None])[:, None, :]
+            fc = self._fc(a_use)[:, None, None]
+            if self.ns_independent:
+                prof = Nc * fc + Ns * uk
+            else:
+                prof = Nc * (fc + Ns * uk)
+
+            def integ(M, a):
+                return prof
+
+            out["mean_profile"] = hmc.integrate_over_massfunc_grid(
+                integ, cosmo, a_use) / ngal[:, None]
+            out["bias_profile"] = hmc.integrate_over_massfunc_grid(
+                integ, cosmo, a_use, with_bias=True) / ngal[:, None]
+            if np.ndim(k) == 0:
+                for name in ["mean_profile", "bias_profile"]:
+                    out[name] = np.squeeze(out[name], axis=-1)
+
+        if np.ndim(a) == 0:
+            out = {name: np.squeeze(val, axis=0) for name, val in out.items()}
+        return out
+
     def _fourier(self, cosmo, k, M, a):
         M_use = np.atleast_1d(M)
         k_use = np.atleast_1d(k)
@@ -385,6 +478,15 @@ class HaloProfileHOD(HaloProfile):
             prof = np.squeeze(prof, axis=0)
         return prof
 
+    def _Ntot(self, M, a):
+        # Total number of galaxies
+        Nc = self._Nc(M, a)
+        Ns = self._Ns(M, a)
+        fc = self._fc(a)
+        if self.ns_independent:
+            return Nc*fc + Ns
+        return Nc*(fc + Ns)
+
     def _fc(self, a):
         # Observed fraction of centrals
         return self.fc_0 + self.fc_p * (a - self.a_pivot)
@@ -1,11 +1,32 @@
 __all__ = ("HaloProfilePressureGNFW",)
 
+import functools
+
 import numpy as np
 
-from ... import UnlockInstance
+from ... import UnlockInstance, check, lib
 from . import HaloProfilePressure
 
 
+@functools.lru_cache(maxsize=32)
+def _gnfw_fourier_table(alpha, beta, gamma, c500, x_out,
+                        qmin, qmax, nq, padding_lo, padding_hi,
+                        n_per_decade):
+    # Fourier-space GNFW template F(q) = int dx x^2 p(x) j_0(qx),
+    # computed in C through FFTLog, and its interpolator.
+    from scipy.interpolate import interp1d
+
+    q_arr = np.geomspace(qmin, qmax, nq)
+    status = 0
+    f_arr, status = lib.gnfw_fourier_table_vec(
+        alpha, beta, gamma, c500, x_out, padding_lo, padding_hi,
+        n_per_decade, q_arr, nq, status)
+    check(status)
+    return interp1d(np.log(q_arr), f_arr,
+                    fill_value="extrapolate",
+                    bounds_error=False)
+
+
 class HaloProfilePressureGNFW(HaloProfilePressure):
     """ Generalized NFW electron pressure profile by
     `Arnaud et al. 2010 <https://arxiv.org/abs/0910.1234>`_.
@@ -101,7 +122,8 @@ class HaloProfilePressureGNFW(HaloProfilePressure):
         .. note::
 
             A change in ``alpha``, ``beta``, ``gamma``, ``c500``, or ``x_out``
-            recomputes the Fourier-space template, which may be slow.
+            recomputes the Fourier-space template, unless a profile with
+            the same shape parameters has computed it recently.
 
         Args:
             mass_bias (:obj:`float`):
@@ -160,28 +182,16 @@ class HaloProfilePressureGNFW(HaloProfilePressure):
         return f1*f2
 
     def _integ_interp(self):
-        # Precomputes the Fourier transform of the profile in terms
-        # of the scaled radius x and creates a spline interpolator
-        # for it.
-        from scipy.interpolate import interp1d
-        from scipy.integrate import quad
-
-        def integrand(x):
-            return self._form_factor(x)*x
-
-        q_arr = np.geomspace(self.qrange[0], self.qrange[1], self.nq)
-        # We use the `weight` feature of quad to quickly estimate
-        # the Fourier transform. We could use the existing FFTLog
-        # framework, but this is a lot less of a kerfuffle.
-        f_arr = np.array([quad(integrand,
-                               a=1e-4, b=self.x_out,  # limits of integration
-                               weight="sin",  # fourier sine weight
-                               wvar=q)[0] / q
-                          for q in q_arr])
-        Fq = interp1d(np.log(q_arr), f_arr,
-                      fill_value="extrapolate",
-                      bounds_error=False)
-        return Fq
+        # Returns a spline interpolator for the Fourier transform of the
+        # profile in terms of the scaled radius x. Tables are shared by
+        # all profiles with the same shape parameters.
+        return _gnfw_fourier_table(
+            float(self.alpha), float(self.beta), float(self.gamma),
+            float(self.c500), float(self.x_out),
+            float(self.qrange[0]), float(self.qrange[1]), int(self.nq),
+            float(self.precision_fftlog["padding_lo_fftlog"]),
+            float(self.precision_fftlog["padding_hi_fftlog"]),
+            float(self.precision_fftlog["n_per_decade"]))
 
     def _norm(self, cosmo, M, a, mb):
         # Computes the normalization factor of the GNFW profile.
@@ -91,6 +91,28 @@ class HaloProfile(CCLAutoRepr):
         """
         return 1.0
 
+    def get_normalization_grid(self, cosmo, a, *, hmc=None):
+        """Returns the normalization of this profile (see
+        :meth:`get_normalization`) for a set of scale factors.
+        Profiles whose normalization comes from a mass integral may
+        override this to compute all scale factors in one pass.
+
+        Args:
+            cosmo (:class:`~pyccl.cosmology.Cosmology`): a Cosmology object.
+            a (:obj:`float` or `array`): scale factors.
+            hmc (:class:`~pyccl.halos.halo_model.HMCalculator`): a halo
+                model calculator object.
+
+        Returns:
+            (:obj:`float` or `array`): normalization factors.
+        """
+        a_use = np.atleast_1d(a).astype(float)
+        norm = np.array([self.get_normalization(cosmo, aa, hmc=hmc)
+                         for aa in a_use])
+        if np.ndim(a) == 0:
+            return norm[0]
+        return norm
+
     @unlock_instance(mutate=True)
     @functools.wraps(FFTLogParams.update_parameters)
     def update_precision_fftlog(self, **kwargs):
@@ -4,6 +4,13 @@ from .. import CCLAutoRepr
 from . import HaloProfile, HaloProfileHOD, HaloProfileCIBShang12
 
 
+def _outer_2pt(uk1, uk2, M):
+    # (N_M, N_k, N_k) moment with k' along the second axis.
+    if isinstance(M, float):
+        return uk1[None, :] * uk2[:, None]
+    return uk1[:, None, :] * uk2[:, :, None]
+
+
 class Profile2pt(CCLAutoRepr):
     """ This class implements the 1-halo 2-point correlator between
     two halo profiles.
@@ -80,6 +87,11 @@ class Profile2pt(CCLAutoRepr):
         if not (isinstance(prof, HP) and isinstance(prof2, HP)):
             raise TypeError("prof and prof2 must be HaloProfile")
 
+        if (diag is not True) and (not isinstance(k, float)):
+            uk1, uk2 = self.fourier_2pt_factors(cosmo, k, M, a, prof,
+                                                prof2=prof2)
+            return _outer_2pt(uk1, uk2, M)
+
         uk1 = prof.fourier(cosmo, k, M, a)
 
         if prof == prof2:
@@ -87,15 +99,55 @@ class Profile2pt(CCLAutoRepr):
         else:
             uk2 = prof2.fourier(cosmo, k, M, a)
 
-        # TODO: This should be implemented in _fourier_variance
-        if (diag is True) or (isinstance(k, float)):
-            output = uk1 * uk2 * (1 + self.r_corr)
-        elif isinstance(M, float):
-            output = uk1[None, :] * uk2[:, None] * (1 + self.r_corr)
-        else:
-            output = uk1[:, None, :] * uk2[:, :, None] * (1 + self.r_corr)
+        return uk1 * uk2 * (1 + self.r_corr)
+
+    def fourier_2pt_factors(self, cosmo, k, M, a, prof, *, prof2=None):
+        """ Return the two factors whose outer product over wavenumbers
+        is the Fourier-space two-point moment at different wavenumbers
+        :math:`k` and :math:`k'`
+
+        .. math::
+           (1+\\rho_{u_1,u_2})\\langle u_1(k)\\rangle
+           \\langle u_2(k') \\rangle.
+
+        The :math:`(1+\\rho_{u_1,u_2})` factor is absorbed into the first
+        one. The mass integrals of
+        :class:`~pyccl.halos.halo_model.HMCalculator` use these factors
+        directly, so that the `(N_M, N_k, N_k)` array returned by
+        :meth:`fourier_2pt` with ``diag=False`` is never formed.
+
+        Args:
+            cosmo (:class:`~pyccl.cosmology.Cosmology`):
+                a Cosmology object.
+            k (:obj:`float` or `array`):
+                comoving wavenumber in Mpc^-1.
+            M (:obj:`float` or `array`):
+                halo mass in units of M_sun.
+            a (:obj:`float`):
+                scale factor.
+            prof (:class:`~pyccl.halos.profiles.HaloProfile`):
+                first halo profile.
+            prof2 (:class:`~pyccl.halos.profiles.HaloProfile`):
+                second halo profile. If ``None``, `prof` will be used as
+                `prof2`.
+
+        Returns:
+            Tuple of two arrays with the shape of the output of
+            :meth:`~pyccl.halos.profiles.HaloProfile.fourier`.
+        """
+        if prof2 is None:
+            prof2 = prof
+
+        HP = HaloProfile
+        if not (isinstance(prof, HP) and isinstance(prof2, HP)):
+            raise TypeError("prof and prof2 must be HaloProfile")
 
-        return output
+        uk1 = prof.fourier(cosmo, k, M, a)
+        if prof == prof2:
+            uk2 = uk1
+        else:
+            uk2 = prof2.fourier(cosmo, k, M, a)
+        return uk1 * (1 + self.r_corr), uk2
 
 
 class Profile2ptHOD(Profile2pt):
@@ -153,15 +205,29 @@ class Profile2ptHOD(Profile2pt):
 
         # TODO: This should be implemented in _fourier_variance
         if (diag is True) or (isinstance(k, float)):
-            output = prof._fourier_variance(cosmo, k, M, a)
-        elif isinstance(M, float):
-            uk1 = prof.fourier(cosmo, k, M, a)
-            output = uk1[None, :] * uk1[:, None] * (1 + self.r_corr)
-        else:
-            uk1 = prof.fourier(cosmo, k, M, a)
-            output = uk1[:, None, :] * uk1[:, :, None] * (1 + self.r_corr)
+            return prof._fourier_variance(cosmo, k, M, a)
+
+        uk1, uk2 = self.fourier_2pt_factors(cosmo, k, M, a, prof)
+        return _outer_2pt(uk1, uk2, M)
+
+    def fourier_2pt_factors(self, cosmo, k, M, a, prof, *, prof2=None):
+        """ Returns the two factors of the approximation
+        :math:`\\langle u(k) u(k')\\rangle \\simeq
+        (1+\\rho)\\langle u(k)\\rangle\\langle u(k')\\rangle` used
+        at different wavenumbers. See
+        :meth:`~pyccl.halos.profiles_2pt.Profile2pt.fourier_2pt_factors`.
+        Only auto-correlations are allowed.
+        """
+        if prof2 is None:
+            prof2 = prof
+
+        if prof != prof2:
+            raise ValueError("prof and prof2 must be equivalent")
+        HOD = HaloProfileHOD
+        if not (isinstance(prof, HOD) and isinstance(prof2, HOD)):
+            raise TypeError("prof and prof2 must be HaloProfileHOD")
 
-        return output
+        return super().fourier_2pt_factors(cosmo, k, M, a, prof)
 
 
 class Profile2ptCIB(Profile2pt):
@@ -213,14 +279,25 @@ class Profile2ptCIB(Profile2pt):
 
         # TODO: This should be implemented in _fourier_variance
         if (diag is True) or (isinstance(k, float)):
-            output = prof._fourier_variance(cosmo, k, M, a, nu_other=prof2.nu)
-        elif isinstance(M, float):
-            uk1 = prof.fourier(cosmo, k, M, a)
-            uk2 = prof2.fourier(cosmo, k, M, a)
-            output = uk1[None, :] * uk2[:, None] * (1 + self.r_corr)
-        else:
-            uk1 = prof.fourier(cosmo, k, M, a)
-            uk2 = prof2.fourier(cosmo, k, M, a)
-            output = uk1[:, None, :] * uk2[:, :, None] * (1 + self.r_corr)
+            return prof._fourier_variance(cosmo, k, M, a, nu_other=prof2.nu)
+
+        uk1, uk2 = self.fourier_2pt_factors(cosmo, k, M, a, prof,
+                                            prof2=prof2)
+        return _outer_2pt(uk1, uk2, M)
+
+    def fourier_2pt_factors(self, cosmo, k, M, a, prof, *, prof2=None):
+        """ Returns the two factors of the approximation
+        :math:`\\langle u_1(k) u_2(k')\\rangle \\simeq
+        (1+\\rho)\\langle u_1(k)\\rangle\\langle u_2(k')\\rangle`
+        used at different wavenumbers. See
+        :meth:`~pyccl.halos.profiles_2pt.Profile2pt.fourier_2pt_factors`.
+        """
+        if prof2 is None:
+            prof2 = prof
+
+        Shang12 = HaloProfileCIBShang12
+        if not (isinstance(prof, Shang12) and isinstance(prof2, Shang12)):
+            raise TypeError("prof and prof2 must be HaloProfileCIB")
 
-        return output
+        return super().fourier_2pt_factors(cosmo, k, M, a, prof,
+                                           prof2=prof2)
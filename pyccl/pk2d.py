@@ -160,6 +160,11 @@ class Pk2D(CCLObject):
     def extrap_order_hik(self):
         return self.psp.extrap_order_hik if self else None
 
+    @property
+    def nbytes(self):
+        """Number of bytes held by the C-level splines of this object."""
+        return lib.f2d_t_size(self.psp) if self else 0
+
     @classmethod
     def from_model(cls, cosmo, model):
         """:class:`Pk2D` constructor returning the power spectrum
@@ -0,0 +1,313 @@
+"""
+============================================
+Precision profiles (:mod:`pyccl.precision`)
+============================================
+
+Named sets of spline and GSL accuracy parameters, and a tool to find the
+cheapest set that meets a given accuracy budget.
+
+A precision profile is a dictionary with (optional) ``'spline_params'`` and
+``'gsl_params'`` entries, each mapping parameter names to values. Three
+built-in profiles are available:
+
+- ``'fast'``: coarser splines and looser tolerances, for sub-percent
+  accuracy at a fraction of the cost.
+- ``'default'``: the CCL defaults.
+- ``'high'``: finer splines and tighter tolerances, useful as a reference.
+
+Profiles only affect :class:`~pyccl.cosmology.Cosmology` objects created
+after they are set, since each cosmology copies the parameters on creation.
+"""
+__all__ = ("PRECISION_PROFILES", "set_precision", "get_precision",
+           "precision_scope", "read_precision_profile",
+           "write_precision_profile", "tune_precision",)
+
+import contextlib
+from copy import deepcopy
+from time import time
+
+import numpy as np
+import yaml
+
+from . import CCLParameters, gsl_params, spline_params
+
+
+PRECISION_PROFILES = {
+    "fast": {
+        "spline_params": {
+            "A_SPLINE_NA": 120,
+            "A_SPLINE_NLOG": 120,
+            "A_SPLINE_NA_PK": 20,
+            "A_SPLINE_NLOG_PK": 6,
+            "A_SPLINE_NA_SM": 8,
+            "A_SPLINE_NLOG_SM": 4,
+            "LOGM_SPLINE_NM": 30,
+            "N_K": 80,
+            "DLOGK_INTEGRATION": 0.05,
+            "DCHI_INTEGRATION": 10.,
+        },
+        "gsl_params": {
+            "INTEGRATION_EPSREL": 1E-3,
+            "INTEGRATION_LIMBER_EPSREL": 1E-3,
+            "INTEGRATION_DISTANCE_EPSREL": 1E-5,
+            "INTEGRATION_SIGMAR_EPSREL": 1E-4,
+            "INTEGRATION_KNL_EPSREL": 1E-4,
+            "ODE_GROWTH_EPSREL": 1E-5,
+        },
+    },
+    "default": {"spline_params": {}, "gsl_params": {}},
+    "high": {
+        "spline_params": {
+            "A_SPLINE_NA": 500,
+            "A_SPLINE_NLOG": 500,
+            "A_SPLINE_NA_PK": 80,
+            "A_SPLINE_NLOG_PK": 22,
+            "A_SPLINE_NA_SM": 26,
+            "A_SPLINE_NLOG_SM": 12,
+            "LOGM_SPLINE_NM": 100,
+            "N_K": 334,
+            "DLOGK_INTEGRATION": 0.0125,
+            "DCHI_INTEGRATION": 2.5,
+        },
+        "gsl_params": {
+            "INTEGRATION_EPSREL": 1E-5,
+            "INTEGRATION_LIMBER_EPSREL": 1E-5,
+            "INTEGRATION_DISTANCE_EPSREL": 1E-8,
+            "INTEGRATION_SIGMAR_EPSREL": 1E-7,
+            "INTEGRATION_KNL_EPSREL": 1E-7,
+            "ODE_GROWTH_EPSREL": 1E-8,
+        },
+    },
+}
+
+# Parameters explored by `tune_precision`, with their candidate values
+# sorted from cheapest to most expensive.
+_TUNABLE = {
+    ("spline_params", "A_SPLINE_NA"): [60, 120, 250, 500],
+    ("spline_params", "A_SPLINE_NLOG"): [60, 120, 250, 500],
+    ("spline_params", "A_SPLINE_NA_PK"): [10, 20, 40, 80],
+    ("spline_params", "A_SPLINE_NLOG_PK"): [3, 6, 11, 22],
+    ("spline_params", "N_K"): [40, 80, 167, 334],
+    ("spline_params", "DLOGK_INTEGRATION"): [0.1, 0.05, 0.025, 0.0125],
+    ("gsl_params", "INTEGRATION_DISTANCE_EPSREL"): [1E-4, 1E-5, 1E-6, 1E-8],
+    ("gsl_params", "ODE_GROWTH_EPSREL"): [1E-4, 1E-5, 1E-6, 1E-8],
+    ("gsl_params", "INTEGRATION_LIMBER_EPSREL"): [1E-2, 1E-3, 1E-4, 1E-5],
+    ("gsl_params", "INTEGRATION_SIGMAR_EPSREL"): [1E-3, 1E-4, 1E-5, 1E-7],
+}
+
+_DEFAULT_TARGETS = {"distances": 1E-5, "growth": 1E-5,
+                    "pk": 1E-3, "cls": 1E-3}
+
+_SECTIONS = {"spline_params": spline_params, "gsl_params": gsl_params}
+
+
+def _get_profile(profile):
+    """Turn a profile name, file name or dictionary into a dictionary."""
+    if isinstance(profile, str):
+        if profile in PRECISION_PROFILES:
+            return PRECISION_PROFILES[profile]
+        return read_precision_profile(profile)
+    if not isinstance(profile, dict):
+        raise TypeError("`profile` must be a profile name, a file name, "
+                        "or a dictionary.")
+    return profile
+
+
+def set_precision(profile="default"):
+    """Set the global spline and GSL parameters from a precision profile.
+    Parameters not listed in the profile are reset to their defaults.
+
+    Args:
+        profile (:obj:`str` or :obj:`dict`): name of a built-in profile
+            (``'fast'``, ``'default'`` or ``'high'``), name of a YAML file
+            written by :func:`write_precision_profile`, or a dictionary with
+            ``'spline_params'`` and/or ``'gsl_params'`` entries.
+    """
+    profile = _get_profile(profile)
+    unknown = set(profile) - set(_SECTIONS) - {"validation"}
+    if unknown:
+        raise KeyError(f"Unknown precision profile sections {unknown}.")
+
+    for section, params in _SECTIONS.items():
+        params.reload()
+        for name, value in profile.get(section, {}).items():
+            params[name] = value
+
+
+def get_precision():
+    """Get the current values of the parameters that precision profiles
+    can modify.
+
+    Returns:
+        :obj:`dict`: precision profile matching the current parameters.
+    """
+    names = {section: set() for section in _SECTIONS}
+    for prof in PRECISION_PROFILES.values():
+        for section in _SECTIONS:
+            names[section] |= set(prof.get(section, {}))
+    return {section: {name: params[name] for name in sorted(names[section])}
+            for section, params in _SECTIONS.items()}
+
+
+@contextlib.contextmanager
+def precision_scope(profile):
+    """Context manager that sets a precision profile and restores the
+    previous parameters on exit.
+
+    Example:
+        >>> with ccl.precision_scope("fast"):
+        ...     cosmo = ccl.CosmologyVanillaLCDM()
+
+    Args:
+        profile (:obj:`str` or :obj:`dict`): see :func:`set_precision`.
+    """
+    backup = {section: CCLParameters.get_params_dict(params)
+              for section, params in _SECTIONS.items()}
+    try:
+        set_precision(profile)
+        yield
+    finally:
+        for section, params in _SECTIONS.items():
+            for name, value in backup[section].items():
+                params[name] = value
+
+
+def write_precision_profile(profile, filename):
+    """Write a precision profile to a YAML file.
+
+    Args:
+        profile (:obj:`str` or :obj:`dict`): see :func:`set_precision`.
+        filename (:obj:`str`): file name, file pointer, or stream to write
+            the profile to.
+    """
+    profile = deepcopy(_get_profile(profile))
+    if isinstance(filename, str):
+        with open(filename, "w") as fp:
+            return yaml.dump(profile, fp, sort_keys=False)
+    return yaml.dump(profile, filename, sort_keys=False)
+
+
+def read_precision_profile(filename):
+    """Read a precision profile from a YAML file.
+
+    Args:
+        filename (:obj:`str`): file name, file pointer, or stream to read
+            the profile from.
+
+    Returns:
+        :obj:`dict`: precision profile.
+    """
+    if isinstance(filename, str):
+        with open(filename, "r") as fp:
+            return yaml.safe_load(fp)
+    return yaml.safe_load(filename)
+
+
+def _observables(cosmo_kwargs):
+    """Quantities used to validate a precision profile."""
+    from . import (Cosmology, WeakLensingTracer, angular_cl,
+                   comoving_radial_distance, growth_factor,
+                   nonlin_matter_power)
+
+    cosmo = Cosmology(**cosmo_kwargs)
+    a = np.linspace(0.2, 1., 9)
+    k = np.geomspace(1E-3, 5., 32)
+    z = np.linspace(0., 2., 128)
+    nz = np.exp(-0.5*((z-0.7)/0.2)**2)
+    ell = np.geomspace(10., 3000., 12)
+
+    t = WeakLensingTracer(cosmo, dndz=(z, nz))
+    return {"distances": comoving_radial_distance(cosmo, a),
+            "growth": growth_factor(cosmo, a),
+            "pk": np.array([nonlin_matter_power(cosmo, k, aa)
+                            for aa in a[::2]]),
+            "cls": angular_cl(cosmo, t, t, ell)}
+
+
+def _max_errors(profile, cosmologies, references):
+    """Maximum relative error of each observable over all cosmologies."""
+    errors = {}
+    with precision_scope(profile):
+        for kwargs, ref in zip(cosmologies, references):
+            obs = _observables(kwargs)
+            for q, val in obs.items():
+                err = np.max(np.abs(val/ref[q]-1))
+                errors[q] = max(errors.get(q, 0.), float(err))
+    return errors
+
+
+def tune_precision(cosmologies, *, targets=None, filename=None):
+    """Find the cheapest spline and GSL settings meeting a set of accuracy
+    targets over a range of cosmologies.
+
+    The comoving distance, growth factor, non-linear matter power spectrum
+    and a weak lensing angular power spectrum of each cosmology are first
+    computed with the ``'high'`` profile and used as reference. Each
+    tunable parameter is then visited in turn, and set to its cheapest
+    candidate value that keeps the maximum relative error of all
+    observables below the targets. The final profile is validated against
+    the reference once more.
+
+    Args:
+        cosmologies (:obj:`list`): :class:`~pyccl.cosmology.Cosmology`
+            objects, or dictionaries of arguments to create them, spanning
+            the parameter space of interest.
+        targets (:obj:`dict`): maximum relative errors allowed for
+            ``'distances'``, ``'growth'``, ``'pk'`` and ``'cls'``. Missing
+            entries take their default values (:math:`10^{-5}` for
+            distances and growth, :math:`10^{-3}` for the power spectra).
+        filename (:obj:`str`): if not ``None``, the profile is written to
+            this file with :func:`write_precision_profile`.
+
+    Returns:
+        :obj:`dict`: precision profile. Its ``'validation'`` entry holds the
+        maximum relative errors found, the targets, and the time taken to
+        compute the observables with the tuned and reference profiles.
+    """
+    from . import Cosmology
+
+    targets = {**_DEFAULT_TARGETS, **(targets or {})}
+    unknown = set(targets) - set(_DEFAULT_TARGETS)
+    if unknown:
+        raise KeyError(f"Unknown accuracy targets {unknown}.")
+    cosmologies = [c.to_dict() if isinstance(c, Cosmology) else dict(c)
+                   for c in cosmologies]
+
+    reference = deepcopy(PRECISION_PROFILES["high"])
+    t0 = time()
+    with precision_scope(reference):
+        references = [_observables(kwargs) for kwargs in cosmologies]
+    t_reference = time() - t0
+
+    profile = deepcopy(reference)
+    for (section, name), candidates in _TUNABLE.items():
+        for value in candidates:
+            if value == reference[section][name]:
+                # The reference value always passes.
+                profile[section][name] = value
+                break
+            trial = deepcopy(profile)
+            trial[section][name] = value
+            errors = _max_errors(trial, cosmologies, references)
+            if all(errors[q] <= targets[q] for q in targets):
+                profile = trial
+                break
+
+    # Parameters interact, so choices that pass one at a time may fail
+    # together. If so, restore the last ones to their reference values
+    # until the profile passes.
+    tuned = list(_TUNABLE)
+    while True:
+        t0 = time()
+        errors = _max_errors(profile, cosmologies, references)
+        t_profile = time() - t0
+        if all(errors[q] <= targets[q] for q in targets) or not tuned:
+            break
+        section, name = tuned.pop()
+        profile[section][name] = reference[section][name]
+
+    profile["validation"] = {"max_errors": errors, "targets": targets,
+                             "time": t_profile, "time_reference": t_reference}
+    if filename is not None:
+        write_precision_profile(profile, filename)
+    return profile
@@ -3,14 +3,15 @@ well as wrappers to automatically vectorize functions.
 """
 __all__ = (
     "CLevelErrors", "ExtrapolationMethods", "IntegrationMethods", "check",
-    "debug_mode", "get_pk_spline_lk", "get_pk_spline_a", "resample_array")
+    "debug_mode", "get_pk_spline_lk", "get_pk_spline_a", "resample_array",
+    "spherical_bessel_jl",)
 
 from enum import Enum
 from typing import Iterable
 
 import numpy as np
 
-from . import CCLError, lib, spline_params
+from . import CCLError, cache, lib, spline_params
 
 
 NoneArr = np.array([])
@@ -603,6 +604,40 @@ def _fftlog_transform_general(
     return ks, fks
 
 
+@cache(maxsize=8)
+def spherical_bessel_jl(l_max, x):
+    """Compute the spherical Bessel functions :math:`j_\\ell(x)` for all
+    orders :math:`0\\leq\\ell\\leq\\ell_{\\rm max}` on an array of
+    arguments. This uses the upward recurrence relation where it is
+    stable, vectorized over ``x``, and Miller's downward recurrence
+    elsewhere, and is much faster than evaluating each order separately.
+
+    If caching is enabled (see :class:`~pyccl._core.caching.Caching`), the
+    tables are stored and reused for the same ``l_max`` and ``x``. The
+    returned array is read-only, as it may be shared between calls.
+
+    Args:
+        l_max (:obj:`int`): maximum order.
+        x (`array`): arguments (e.g. :math:`k\\chi` on a grid).
+
+    Returns:
+        `array`: :math:`j_\\ell(x)` with shape ``(l_max+1,) + x.shape``.
+    """
+    l_max = int(l_max)
+    if l_max < 0:
+        raise ValueError("l_max must be non-negative")
+    x_use = np.ascontiguousarray(x, dtype=float)
+
+    status = 0
+    jl, status = lib.spherical_bessel_array(l_max, x_use.ravel(),
+                                            (l_max+1)*x_use.size, status)
+    check(status)
+
+    jl = jl.reshape((l_max+1,) + x_use.shape)
+    jl.setflags(write=False)
+    return jl
+
+
 def _spline_integrate(x, ys, a, b):
     if np.ndim(x) != 1:
         raise ValueError("x should be a 1D array")
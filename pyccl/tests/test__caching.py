@@ -164,5 +164,71 @@ def test_caching_parentheses():
     assert all([hasattr(func, "cache_info") for func in [func1, func2]])
 
 
+def test_caching_disk(tmp_path):
+    """Verify that the on-disk cache is reused across cleared caches."""
+    calls = []
+
+    @ccl.cache(disk=True)
+    def func(x):
+        calls.append(x)
+        return np.arange(x)
+
+    ccl.Caching.enable_disk_cache(path=tmp_path)
+    disk = ccl.Caching.get_disk_cache()
+    assert str(tmp_path) in repr(disk)
+    try:
+        # Works even if in-memory caching is disabled.
+        ccl.Caching.disable()
+        assert np.array_equal(func(3), np.arange(3))
+        assert np.array_equal(func(3), np.arange(3))
+        assert calls == [3]
+        assert func.cache_info.disk_hits == 1
+
+        # Corrupted entries are recomputed.
+        for fname in tmp_path.iterdir():
+            fname.write_bytes(b"not a pickle")
+        assert np.array_equal(func(3), np.arange(3))
+        assert calls == [3, 3]
+
+        # Unpicklable outputs are not stored.
+        @ccl.cache(disk=True)
+        def func2():
+            return lambda: None
+
+        with pytest.warns(RuntimeWarning):
+            func2()
+
+        disk.clear()
+        assert not list(tmp_path.glob("*.pkl"))
+    finally:
+        ccl.Caching.disable_disk_cache()
+    assert ccl.Caching.get_disk_cache() is None
+
+
+def test_caching_disk_pk_linear(tmp_path, monkeypatch):
+    """Linear power spectra from Boltzmann codes are stored on disk."""
+    cosmo = ccl.CosmologyVanillaLCDM(transfer_function="boltzmann_camb")
+    cosmo.compute_linear_power()
+    pk = cosmo.get_linear_power()
+
+    ccl.Caching.enable_disk_cache(path=tmp_path)
+    try:
+        cosmo1 = ccl.CosmologyVanillaLCDM(transfer_function="boltzmann_camb")
+        cosmo1.compute_linear_power()
+        assert len(list(tmp_path.glob("*.pkl"))) == 1
+
+        # The second cosmology never calls the Boltzmann code.
+        cosmo2 = ccl.CosmologyVanillaLCDM(transfer_function="boltzmann_camb")
+
+        def fail(*args, **kwargs):
+            raise AssertionError("Boltzmann code should not be called.")
+
+        monkeypatch.setattr(ccl.Cosmology, "_compute_linear_power", fail)
+        cosmo2.compute_linear_power()
+        assert cosmo2.get_linear_power() == cosmo1.get_linear_power() == pk
+    finally:
+        ccl.Caching.disable_disk_cache()
+
+
 # Revert to defaults.
 ccl.Caching._enabled = DEFAULT_CACHING_STATUS
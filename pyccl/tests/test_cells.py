@@ -155,6 +155,32 @@ def test_fkem_chi_params():
     assert np.all(np.fabs(cl_ggn_b/cl_gg-1)[ell_good] < 0.01)
 
 
+def test_cells_extended_limber():
+    z = np.linspace(0, 4.72, 60)
+    nz = z**2*np.exp(-0.5*((z-1.5)/0.7)**2)
+    bz = np.ones_like(z)
+    cosmo = ccl.CosmologyVanillaLCDM()
+    tracer_gal = ccl.NumberCountsTracer(cosmo, has_rsd=False,
+                                        dndz=(z, nz), bias=(z, bz))
+
+    # The correction is small on small scales
+    ls = np.array([500., 1000., 2000.])
+    cl1 = ccl.angular_cl(cosmo, tracer_gal, tracer_gal, ls)
+    cl2 = ccl.angular_cl(cosmo, tracer_gal, tracer_gal, ls, limber_order=2)
+    assert np.all(np.fabs(cl2/cl1-1) < 1E-3)
+
+    # And brings Limber closer to the exact result on large scales
+    ls = np.array([8., 12.])
+    cl1 = ccl.angular_cl(cosmo, tracer_gal, tracer_gal, ls)
+    cl2 = ccl.angular_cl(cosmo, tracer_gal, tracer_gal, ls, limber_order=2)
+    cln = ccl.angular_cl(cosmo, tracer_gal, tracer_gal, ls,
+                         l_limber=1000, fkem_chi_min=1.0, fkem_Nchi=100)
+    assert np.all(np.fabs(cl2/cln-1) < np.fabs(cl1/cln-1))
+
+    with pytest.raises(ValueError):
+        ccl.angular_cl(cosmo, tracer_gal, tracer_gal, ls, limber_order=3)
+
+
 def test_cells_mg():
     # Check that if we feed the non-linear matter power spectrum from a MG
     # cosmology into a Calculator and get Cells using MG tracers, we get the
@@ -188,3 +214,177 @@ def test_cells_mg():
 
 
 ccl.gsl_params.reload()  # reset to the default parameters
+
+
+@pytest.mark.parametrize("method", ["qag_quad", "spline"])
+def test_cells_batch(method):
+    ell = np.geomspace(10, 1000, 8)
+    cosmos = [ccl.Cosmology(Omega_c=0.27, Omega_b=0.045, h=0.67,
+                            sigma8=s8, n_s=0.96, transfer_function="bbks",
+                            matter_power_spectrum="linear")
+              for s8 in [0.78, 0.8, 0.82]]
+    trs = [ccl.WeakLensingTracer(c, dndz=(ZZ, NN)) for c in cosmos]
+
+    cl = ccl.angular_cl_batch(cosmos, trs, trs, ell,
+                              limber_integration_method=method)
+    assert cl.shape == (3, ell.size)
+    for c, t, cl_b in zip(cosmos, trs, cl):
+        cl_c = ccl.angular_cl(c, t, t, ell, limber_integration_method=method)
+        assert np.allclose(cl_b, cl_c, atol=0, rtol=1E-12)
+
+    cl = ccl.angular_cl_batch(cosmos, trs, trs, 100., p_of_k_a=[PKA]*3)
+    assert cl.shape == (3,)
+    assert np.allclose(cl, ccl.angular_cl(cosmos[0], trs[0], trs[0], 100.,
+                                          p_of_k_a=PKA),
+                       atol=0, rtol=1E-3)
+
+    with pytest.raises(ValueError):
+        ccl.angular_cl_batch(cosmos, trs[:2], trs, ell)
+    with pytest.raises(ValueError):
+        ccl.angular_cl_batch(cosmos, trs, trs, ell, p_of_k_a=[PKA])
+    with pytest.raises(ValueError):
+        ccl.angular_cl_batch(cosmos, trs, trs, ell,
+                             limber_integration_method="guad")
+
+
+def test_cells_bandpowers():
+    from scipy.sparse import csr_matrix
+
+    l_max = 600
+    edges = np.linspace(10, l_max+1, 11).astype(int)
+    windows = np.zeros([10, l_max+1])
+    for b, (l0, lf) in enumerate(zip(edges[:-1], edges[1:])):
+        windows[b, l0:lf] = 1./(lf-l0)
+    cl = ccl.angular_cl(COSMO, LENS, LENS, np.arange(l_max+1))
+    bp_p = windows @ cl
+
+    bp = ccl.angular_cl_bandpowers(COSMO, LENS, LENS, windows)
+    assert bp.shape == (10,)
+    assert np.allclose(bp, bp_p, atol=0, rtol=1E-10)
+
+    bp = ccl.angular_cl_bandpowers(COSMO, LENS, LENS, csr_matrix(windows))
+    assert np.allclose(bp, bp_p, atol=0, rtol=1E-10)
+
+    # Sampled multipoles
+    bp = ccl.angular_cl_bandpowers(COSMO, LENS, LENS, windows,
+                                   n_ell_sample=100)
+    assert np.allclose(bp, bp_p, atol=0, rtol=1E-3)
+
+    with pytest.raises(ValueError):
+        ccl.angular_cl_bandpowers(COSMO, LENS, LENS, windows,
+                                  n_ell_sample=3)
+    with pytest.raises(ValueError):
+        ccl.angular_cl_bandpowers(COSMO, LENS, LENS, np.zeros([2, 10]))
+    with pytest.raises(ValueError):
+        ccl.angular_cl_bandpowers(COSMO, LENS, LENS, windows,
+                                  limber_integration_method="guad")
+
+
+def test_cells_data_vector():
+    z = np.linspace(0.0, 1.0, 200)
+    n = np.exp(-(((z - 0.5) / 0.1) ** 2))
+    clu = ccl.NumberCountsTracer(COSMO, has_rsd=False, dndz=(z, n),
+                                 bias=(z, np.ones_like(z)))
+    ell = np.geomspace(10, 1000, 8)
+    theta = np.geomspace(0.05, 2., 6)
+    ell_sample = np.geomspace(2., 3E4, 100)
+    pairs = [(LENS, LENS, 'GG+'), (LENS, LENS, 'GG-'), (clu, LENS, 'NG'),
+             (clu, clu, 'NN'), (clu, LENS, 'cl')]
+    cuts = [(0.1, 10.), None, (0., 1.), None, (20., 500.)]
+
+    dv = ccl.angular_data_vector(COSMO, pairs, ell=ell, theta=theta,
+                                 scale_cuts=cuts, ell_sample=ell_sample)
+
+    dv_p = []
+    for (t1, t2, typ), cut in zip(pairs, cuts):
+        x = ell if typ == 'cl' else theta
+        if cut is not None:
+            x = x[(x >= cut[0]) & (x <= cut[1])]
+        if typ == 'cl':
+            dv_p.append(ccl.angular_cl(COSMO, t1, t2, x))
+        else:
+            cl = ccl.angular_cl(COSMO, t1, t2, ell_sample)
+            dv_p.append(ccl.correlation(COSMO, ell=ell_sample, C_ell=cl,
+                                        theta=x, type=typ))
+    dv_p = np.concatenate(dv_p)
+    assert dv.shape == dv_p.shape
+    assert np.allclose(dv, dv_p, atol=0, rtol=1E-8)
+
+    # Power spectra only
+    dv = ccl.angular_data_vector(COSMO, [(LENS, LENS, 'cl')], ell=ell)
+    assert np.allclose(dv, ccl.angular_cl(COSMO, LENS, LENS, ell),
+                       atol=0, rtol=1E-12)
+
+    with pytest.raises(ValueError):
+        ccl.angular_data_vector(COSMO, [(LENS, LENS, 'GG')], theta=theta)
+    with pytest.raises(ValueError):
+        ccl.angular_data_vector(COSMO, [(LENS, LENS, 'cl')], theta=theta)
+    with pytest.raises(ValueError):
+        ccl.angular_data_vector(COSMO, [(LENS, LENS, 'GG+')], ell=ell)
+    with pytest.raises(ValueError):
+        ccl.angular_data_vector(COSMO, pairs, ell=ell, theta=theta,
+                                scale_cuts=cuts[:2])
+    with pytest.raises(ValueError):
+        ccl.angular_data_vector(COSMO, pairs, ell=ell, theta=theta,
+                                ell_sample=ell_sample[::-1])
+
+
+def test_cells_derivatives_linear():
+    # Derivatives equal to the kernels or the power spectrum themselves
+    # must give back (multiples of) the power spectrum.
+    ell = np.geomspace(10, 1000, 8)
+    kernels, chis = LENS.get_kernel()
+    dlens = LENS.with_kernels(COSMO, list(zip(chis, kernels)))
+    a, lk, pk = COSMO.get_nonlin_power().get_spline_arrays()
+    dpk = ccl.Pk2D(a_arr=a, lk_arr=lk, pk_arr=pk, is_logp=False)
+
+    cl = ccl.angular_cl(COSMO, LENS, LENS, ell,
+                        limber_integration_method="spline")
+    dcl = ccl.angular_cl_derivatives(COSMO, LENS, LENS, ell,
+                                     dp_of_k_a=[dpk, None, None],
+                                     dtracer1=[None, dlens, dlens],
+                                     dtracer2=[None, None, dlens])
+    assert dcl.shape == (3, ell.size)
+    assert np.allclose(dcl[0], cl, atol=0, rtol=1E-3)
+    assert np.allclose(dcl[1], cl, atol=0, rtol=1E-4)
+    assert np.allclose(dcl[2], 2*cl, atol=0, rtol=1E-4)
+
+    dcl = ccl.angular_cl_derivatives(COSMO, LENS, LENS, 100.,
+                                     dtracer1=[dlens])
+    assert dcl.shape == (1,)
+
+
+def test_cells_derivatives_raises():
+    with pytest.raises(ValueError):
+        ccl.angular_cl_derivatives(COSMO, LENS, LENS, 100.)
+    with pytest.raises(ValueError):
+        ccl.angular_cl_derivatives(COSMO, LENS, LENS, 100.,
+                                   dtracer1=[LENS], dtracer2=[LENS, LENS])
+    with pytest.raises(ValueError):
+        ccl.angular_cl_derivatives(COSMO, LENS, LENS, 100.,
+                                   dp_of_k_a=[PKA])
+    with pytest.raises(ValueError):
+        LENS.with_kernels(COSMO, [])
+
+
+def test_cells_gradient():
+    ell = np.geomspace(10, 1000, 8)
+    step = 0.01
+
+    def get_tracers(cosmo):
+        t = ccl.WeakLensingTracer(cosmo, dndz=(ZZ, NN))
+        return t, t
+
+    dcl = ccl.angular_cl_gradient(COSMO, get_tracers, ell,
+                                  {"Omega_c": step, "n_s": step})
+    assert dcl.shape == (2, ell.size)
+
+    pars = COSMO.to_dict()
+    for i, name in enumerate(["Omega_c", "n_s"]):
+        cls = []
+        for s in [step, -step]:
+            c = ccl.Cosmology(**{**pars, name: pars[name] + s})
+            cls.append(ccl.angular_cl(c, *get_tracers(c), ell,
+                                      limber_integration_method="spline"))
+        dcl_fd = (cls[0]-cls[1])/(2*step)
+        assert np.allclose(dcl[i], dcl_fd, atol=0, rtol=5E-3)
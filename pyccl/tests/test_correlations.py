@@ -103,6 +103,50 @@ def test_correlation_pi_sigma_smoke(sval):
     assert np.shape(corr) == np.shape(sval)
 
 
+def test_correlation_projected():
+    rp = np.geomspace(1., 50., 8)
+    a = np.array([0.6, 0.8, 1.])
+    pi_max = 60.
+
+    # Vectorised over scale factor
+    wp = ccl.correlation_projected(COSMO, rp=rp, a=a, pi_max=pi_max)
+    assert wp.shape == (3, 8)
+    wp1 = ccl.correlation_projected(COSMO, rp=rp, a=0.8, pi_max=pi_max)
+    assert wp1.shape == (8,)
+    assert np.allclose(wp[1], wp1, rtol=1e-6)
+    assert np.ndim(ccl.correlation_projected(COSMO, rp=10., a=0.8)) == 0
+
+    # Direct line-of-sight integral of xi(r)
+    pi = np.linspace(0, pi_max, 2001)
+    for r, w in zip(rp, wp1):
+        xi = ccl.correlation_3d(COSMO, a=0.8, r=np.sqrt(r**2+pi**2))
+        w_direct = 2*np.sum(0.5*(xi[1:]+xi[:-1])*np.diff(pi))
+        assert np.fabs(w/w_direct-1) < 1e-2
+
+    # An infinite pi_max adds positive large-scale correlations
+    wp_inf = ccl.correlation_projected(COSMO, rp=rp, a=0.8)
+    assert np.all(wp_inf > wp1)
+
+    # RSDs do nothing for pi_max -> infinity, but infall moves pairs
+    # within pi_max, increasing wp at finite pi_max
+    wp_inf_rsd = ccl.correlation_projected(COSMO, rp=rp, a=0.8, beta=0.5)
+    assert np.allclose(wp_inf_rsd, wp_inf, rtol=1e-10)
+    wp_rsd = ccl.correlation_projected(COSMO, rp=rp, a=a, beta=0.5,
+                                       pi_max=pi_max)
+    assert np.all(wp_rsd[:, -1] > wp[:, -1])
+    pi = np.linspace(0, pi_max, 601)
+    xi = np.array([ccl.correlation_pi_sigma(COSMO, pi=p, sigma=rp, a=0.8,
+                                            beta=0.5)
+                   for p in pi])
+    w_direct = 2*np.sum(0.5*(xi[1:]+xi[:-1])*np.diff(pi)[:, None], axis=0)
+    assert np.all(np.fabs(wp_rsd[1]/w_direct-1) < 1e-2)
+
+    with pytest.raises(ValueError):
+        ccl.correlation_projected(COSMO, rp=rp, a=a, pi_max=-1.)
+    with pytest.raises(ValueError):
+        ccl.correlation_projected(COSMO, rp=rp, a=a, beta=[0.5, 0.5])
+
+
 def test_correlation_raises():
     with pytest.raises(ValueError):
         ccl.correlation(COSMO, ell=[1], C_ell=[1e-3], theta=[1], method='blah')
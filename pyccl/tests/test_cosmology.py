@@ -311,3 +311,21 @@ def test_camb_sigma8_input():
         transfer_function="boltzmann_camb"
     )
     assert np.isclose(cosmo.sigma8(), sigma8)
+
+
+def test_cosmology_memory_report():
+    cosmo = ccl.CosmologyVanillaLCDM(transfer_function="bbks",
+                                     matter_power_spectrum="linear")
+    rep = cosmo.get_memory_report()
+    assert rep["background"] == rep["growth"] == 0
+    assert rep["pk_linear"] == rep["pk_nonlin"] == 0
+
+    cosmo.compute_nonlin_power()
+    rep = cosmo.get_memory_report()
+    assert rep["background"] > 0
+    assert rep["growth"] > 0
+    pk = cosmo.get_linear_power()
+    assert rep["pk_linear"] == pk.nbytes > 0
+    # Linear and non-linear P(k) are the same object here
+    assert rep["pk_nonlin"] == 0
+    assert rep["total"] > sum(v for k, v in rep.items() if k != "total")
@@ -171,3 +171,59 @@ def test_Sigma2B():
     a_cosmo = COSMO.get_pk_spline_a()
     assert np.all(a_s == a_cosmo)
     assert len(a_s) == len(s2b)
+
+
+def test_cov_gaussian():
+    # Compare against an explicit loop over tracer quadruples
+    ntr, nell = 3, 5
+    ell = np.linspace(10., 500., nell)
+    dell = np.full(nell, 20.)
+    rng = np.random.default_rng(1234)
+    amp = rng.normal(size=(ntr, ntr, nell))
+    cls = np.einsum('iml,jml->ijl', amp, amp)
+    nls = np.zeros_like(cls)
+    nls[np.arange(ntr), np.arange(ntr)] = 0.1
+    fsky = 0.3
+
+    pairs = np.array(np.triu_indices(ntr)).T
+    tot = cls + nls
+    cov_p = np.array([[(tot[a, c]*tot[b, d]+tot[a, d]*tot[b, c]) /
+                       ((2*ell+1)*fsky*dell)
+                       for c, d in pairs]
+                      for a, b in pairs])
+
+    cov = ccl.angular_cl_cov_gaussian(ell, cls, noise=nls, fsky=fsky,
+                                      delta_ell=20.)
+    assert cov.shape == cov_p.shape
+    assert np.allclose(cov, cov_p, atol=0, rtol=1E-12)
+
+    # Dense matrix is block-diagonal in ell
+    covd = ccl.angular_cl_cov_gaussian(ell, cls, noise=nls, fsky=fsky,
+                                       delta_ell=dell, dense=True)
+    npairs = len(pairs)
+    covd = covd.reshape([npairs, nell, npairs, nell])
+    idx = np.arange(nell)
+    assert np.allclose(covd[:, idx, :, idx],
+                       np.transpose(cov_p, axes=(2, 0, 1)),
+                       atol=0, rtol=1E-12)
+    covd[:, idx, :, idx] = 0
+    assert np.all(covd == 0)
+
+    # Subset of pairs, no noise, unit bin widths
+    sub = [(0, 1), (2, 2)]
+    cov = ccl.angular_cl_cov_gaussian(ell, cls, pairs=sub)
+    assert np.allclose(cov[0, 1], (cls[0, 2]*cls[1, 2]*2)/(2*ell+1),
+                       atol=0, rtol=1E-12)
+
+
+def test_cov_gaussian_errors():
+    cls = np.ones([2, 2, 3])
+    ell = np.arange(3)+2.
+    with pytest.raises(ValueError):
+        ccl.angular_cl_cov_gaussian(ell, cls[0])
+    with pytest.raises(ValueError):
+        ccl.angular_cl_cov_gaussian(ell, cls, pairs=[[0, 1, 1]])
+    with pytest.raises(ccl.CCLError):
+        ccl.angular_cl_cov_gaussian(ell, cls, pairs=[[0, 2]])
+    with pytest.raises(ccl.CCLError):
+        ccl.angular_cl_cov_gaussian(ell, cls, fsky=0.)
@@ -56,6 +56,22 @@ def test_fftlog_plaw(dim, mu, alpha):
     assert np.all(res < 1e-10)
 
 
+@pytest.mark.parametrize("dim", [2, 3])
+def test_fftlog_gaussian(dim):
+    # The d-D Fourier transform of exp(-k^2/2) is
+    # (2\pi)^{-d/2} exp(-r^2/2). Unlike a power law, this pins down
+    # the output grid r.
+    nk = 1024
+    k_arr = np.logspace(-4, 4, nk)
+    fk_arr = np.exp(-0.5 * k_arr**2)
+
+    r_arr, fr_arr = _fftlog_transform(k_arr, fk_arr, dim, 0, -0.5 * dim)
+    fr_arr_pred = (2 * np.pi)**(-0.5 * dim) * np.exp(-0.5 * r_arr**2)
+    good = (r_arr > 0.05) & (r_arr < 3)
+    res = np.fabs(fr_arr[good] / fr_arr_pred[good] - 1)
+    assert np.all(res < 1e-5)
+
+
 def test_fftlog_shapes():
     nk = 1024
     nt = 4
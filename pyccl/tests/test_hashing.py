@@ -1,4 +1,6 @@
 """Test the hashing function of CCL."""
+import subprocess
+import sys
 import pytest
 import pyccl as ccl
 import numpy as np
@@ -23,7 +25,6 @@ def test_hashing_smoke(obj):
 
 
 def test_hashing_large_array():
-    # Hashing ultimately uses the representation of the object.
     # The representation of large numpy arrays only contains the start
     # and the end. We check that the entire array is considered.
     array = np.random.random(64**3).reshape(64, 64, 64)
@@ -32,3 +33,22 @@ def test_hashing_large_array():
     vmax = str(array2.max())[:6]
     assert vmax not in repr(array2)  # make sure it doesn't show
     assert ccl.hash_(array) != ccl.hash_(array2)
+
+
+def test_hashing_stable():
+    # The hash must not depend on the process, so that it can be used
+    # to key the on-disk cache.
+    objs = "{'b': {1, 2, 'x'}, 'a': (np.arange(3.), 1.0, 'y', None)}"
+    code = f"import numpy as np, pyccl; print(pyccl.hash_({objs}))"
+    out = [int(subprocess.check_output([sys.executable, "-c", code]))
+           for _ in range(2)]
+    assert out[0] == out[1] == ccl.hash_(eval(objs))
+
+
+def test_hashing_distinguishes_types():
+    assert len({ccl.hash_(x) for x in [1, 1.0, "1", (1,), [[1]]]}) == 5
+    assert ccl.hash_(np.arange(3.)) != ccl.hash_(np.arange(3))
+    assert ccl.hash_(np.zeros((2, 3))) != ccl.hash_(np.zeros((3, 2)))
+    # Non-contiguous arrays hash by value.
+    arr = np.arange(6.).reshape(2, 3)
+    assert ccl.hash_(arr.T) == ccl.hash_(arr.T.copy())
@@ -85,6 +85,35 @@ def test_translate_mass():
         assert np.shape(m) == np.shape(M)
 
 
+@pytest.mark.parametrize('a', [1., 0.5, 0.005])
+def test_translate_mass_table(a):
+    hmd = ccl.halos.MassDef200m
+    hmdb = ccl.halos.MassDefVir
+    cm = ccl.halos.Concentration.create_instance("Duffy08", mass_def=hmd)
+    translator = ccl.halos.mass_translator(mass_in=hmd, mass_out=hmdb,
+                                           concentration=cm)
+    M = np.geomspace(1E10, 1E15, 16)
+
+    # Direct translation
+    c_in = cm(COSMO, M, a)
+    D_in = hmd.get_Delta(COSMO, a) * COSMO.omega_x(a, hmd.rho_type)
+    D_out = hmdb.get_Delta(COSMO, a) * COSMO.omega_x(a, hmdb.rho_type)
+    c_out = ccl.halos.convert_concentration(COSMO, c_old=c_in,
+                                            Delta_old=D_in,
+                                            Delta_new=D_out)
+    R_out = hmd.get_radius(COSMO, M, a) * c_out / c_in
+    M_pred = hmdb.get_mass(COSMO, R_out, a)
+
+    m, jac = translator(COSMO, M, a, jacobian=True)
+    assert np.all(np.fabs(m / M_pred - 1) < 1E-4)
+    # Jacobian from finite differences
+    h = 1E-3
+    m_p = translator(COSMO, M * np.exp(h), a)
+    m_m = translator(COSMO, M * np.exp(-h), a)
+    jac_pred = np.log(m_p / m_m) / (2 * h)
+    assert np.all(np.fabs(jac - jac_pred) < 1E-4)
+
+
 @pytest.mark.parametrize('scls', [ccl.halos.MassDef200m,
                                   ccl.halos.MassDef200c,
                                   ccl.halos.MassDef500c,
@@ -120,3 +149,45 @@ def test_mass_translator():
                                            concentration=cm)
     cosmo = ccl.CosmologyVanillaLCDM()
     assert translator(cosmo, 1e14, 1) == 1e14
+
+
+def test_mass_translator_concentration_change():
+    # The tabulated translation must follow changes in the concentration.
+    mdef1 = ccl.halos.MassDef200c
+    mdef2 = ccl.halos.MassDef500c
+    cm = ccl.halos.ConcentrationConstant(c=4., mass_def=mdef1)
+    translator = ccl.halos.mass_translator(mass_in=mdef1, mass_out=mdef2,
+                                           concentration=cm)
+    M4 = translator(COSMO, 1e14, 1.)
+    with ccl.UnlockInstance(cm):
+        cm.c = 8.
+    M8 = translator(COSMO, 1e14, 1.)
+
+    cm8 = ccl.halos.ConcentrationConstant(c=8., mass_def=mdef1)
+    translator8 = ccl.halos.mass_translator(mass_in=mdef1, mass_out=mdef2,
+                                            concentration=cm8)
+    assert M8 != M4
+    assert np.isclose(M8, translator8(COSMO, 1e14, 1.), rtol=1E-10, atol=0)
+
+
+@pytest.mark.parametrize('rho_type', ['critical', 'matter'])
+def test_Delta_vir_table(rho_type):
+    # The tabulated overdensity and thresholds match the fitting functions.
+    a = np.linspace(0.05, 1., 17)
+    Om = COSMO.omega_x(a, 'matter')
+    x = Om-1
+    Dv = 18*np.pi**2+82*x-39*x**2
+    if rho_type == 'matter':
+        Dv /= Om
+    hmd = ccl.halos.MassDef('vir', rho_type)
+    assert np.allclose(hmd.get_Delta_vir(COSMO, a), Dv, atol=0, rtol=1E-5)
+    assert np.ndim(hmd.get_Delta_vir(COSMO, 0.5)) == 0
+    assert COSMO.has_halo_background
+
+    dc0 = 1.68647019984
+    dc = ccl.halos.get_delta_c(COSMO, a, kind='NakamuraSuto97')
+    assert np.allclose(dc, dc0*(1+0.012299*np.log10(Om)), atol=0, rtol=1E-6)
+    s8 = COSMO.sigma8()*COSMO.growth_factor(a)
+    dc = ccl.halos.get_delta_c(COSMO, a, kind='Mead16')
+    dc_exp = (1.59+0.0314*np.log(s8))*(1+0.0123*np.log10(Om))
+    assert np.allclose(dc, dc_exp, atol=0, rtol=1E-6)
@@ -80,6 +80,29 @@ def test_pk2d_init():
         ccl.Pk2D(a_arr=aarr[::-1], lk_arr=lkarr, pk_arr=pkarr)
 
 
+def test_pk2d_new_from_power():
+    # Building the spline from P(k) in C matches passing log(P(k)).
+    a_arr = np.linspace(0.1, 1, 10)
+    lk_arr = np.linspace(-4, 1, 50)
+    pk_arr = np.exp(lk_arr)[None, :]**(-1.5)*a_arr[:, None]**2
+    pk1 = ccl.Pk2D(a_arr=a_arr, lk_arr=lk_arr, pk_arr=np.log(pk_arr))
+    pk2 = ccl.Pk2D.__new__(ccl.Pk2D)
+    status = 0
+    with ccl.UnlockInstance(pk2):
+        pk2.psp, status = ccl.lib.set_pk2d_new_from_power(
+            lk_arr, a_arr, pk_arr.flatten(), 1, 2, status)
+    assert status == 0
+    for arr1, arr2 in zip(pk1.get_spline_arrays(), pk2.get_spline_arrays()):
+        assert np.allclose(arr1, arr2, atol=0, rtol=1E-14)
+
+    # P(k) must be positive.
+    pk_arr[3, 7] = 0
+    status = 0
+    _, status = ccl.lib.set_pk2d_new_from_power(
+        lk_arr, a_arr, pk_arr.flatten(), 1, 2, status)
+    assert status == ccl.lib.CCL_ERROR_INCONSISTENT
+
+
 def test_pk2d_smoke():
     """Make sure it works once."""
     cosmo = ccl.Cosmology(
@@ -233,6 +233,96 @@ def test_pkhm_pk2d():
     assert np.allclose(pk3, pk0*fact, rtol=0)
 
 
+@pytest.mark.parametrize('h1,h2', [(True, True), (True, False),
+                                   (False, True)])
+def test_pkhm_cib_multifreq(h1, h2):
+    hmc = ccl.halos.HMCalculator(mass_function=HMF, halo_bias=HBF,
+                                 mass_def=M200)
+    nus = [217., 353., 545.]
+    a_arr = np.array([0.5, 1.])
+    pcib = ccl.halos.HaloProfileCIBShang12(mass_def=M200, concentration=CON,
+                                           nu_GHz=nus[0])
+    p2pt = ccl.halos.Profile2ptCIB()
+    pk = ccl.halos.halomod_power_spectrum_cib(COSMO, hmc, KK, a_arr, pcib,
+                                              nus, get_1h=h1, get_2h=h2)
+    assert pk.shape == (3, 3, 2, len(KK))
+    profs = [ccl.halos.HaloProfileCIBShang12(mass_def=M200, concentration=CON,
+                                             nu_GHz=nu) for nu in nus]
+    for i1, p1 in enumerate(profs):
+        for i2, p2 in enumerate(profs):
+            pk12 = ccl.halos.halomod_power_spectrum(
+                COSMO, hmc, KK, a_arr, p1, prof2=p2, prof_2pt=p2pt,
+                get_1h=h1, get_2h=h2)
+            assert np.allclose(pk[i1, i2], pk12, rtol=1E-10, atol=0)
+
+    # Scalar inputs
+    pk = ccl.halos.halomod_power_spectrum_cib(COSMO, hmc, 0.1, 1., pcib,
+                                              nus[1])
+    assert np.ndim(pk) == 0
+
+    with pytest.raises(TypeError):
+        ccl.halos.halomod_power_spectrum_cib(COSMO, hmc, KK, AA, P1, nus)
+
+
+@pytest.mark.parametrize('ns_independent', [False, True])
+def test_pkhm_hod_moments(ns_independent):
+    hmc = ccl.halos.HMCalculator(mass_function=HMF, halo_bias=HBF,
+                                 mass_def=M200)
+    p = ccl.halos.HaloProfileHOD(mass_def=M200, concentration=CON,
+                                 log10Mmin_p=0.5, alpha_p=0.2,
+                                 ns_independent=ns_independent)
+    a_arr = np.array([0.3, 0.5, 0.8, 1.])
+    mom = p.get_moments(COSMO, a_arr, hmc=hmc, k=KK)
+    assert mom["mean_profile"].shape == (len(a_arr), len(KK))
+
+    for ia, aa in enumerate(a_arr):
+        ng = p.get_normalization(COSMO, aa, hmc=hmc)
+        i01 = hmc.I_0_1(COSMO, KK, aa, p)
+        i11 = hmc.I_1_1(COSMO, KK, aa, p)
+        assert np.isclose(mom["n_g"][ia], ng, rtol=1E-10, atol=0)
+        assert np.isclose(mom["b_eff"][ia], i11[0]/ng, rtol=1E-4, atol=0)
+        assert np.allclose(mom["mean_profile"][ia], i01/ng,
+                           rtol=1E-10, atol=0)
+        assert np.allclose(mom["bias_profile"][ia], i11/ng,
+                           rtol=1E-10, atol=0)
+
+    # The 1-point functions and normalizations use the same tables
+    ng = p.get_normalization_grid(COSMO, a_arr, hmc=hmc)
+    assert np.allclose(ng, mom["n_g"], rtol=1E-12, atol=0)
+    b1 = ccl.halos.halomod_bias_1pt(COSMO, hmc, KK, a_arr, p)
+    assert np.allclose(b1, mom["bias_profile"], rtol=1E-12, atol=0)
+
+    # Scalar inputs
+    mom = p.get_moments(COSMO, 1., hmc=hmc, k=0.1)
+    assert all(np.ndim(v) == 0 for v in mom.values())
+
+
+def test_pkhm_hod_custom_normalization():
+    # Overriding `get_normalization` must not be bypassed by the
+    # tabulated HOD paths
+    class HOD2(ccl.halos.HaloProfileHOD):
+        def get_normalization(self, cosmo, a, *, hmc):
+            return 2*super().get_normalization(cosmo, a, hmc=hmc)
+
+    hmc = ccl.halos.HMCalculator(mass_function=HMF, halo_bias=HBF,
+                                 mass_def=M200)
+    p1 = ccl.halos.HaloProfileHOD(mass_def=M200, concentration=CON)
+    p2 = HOD2(mass_def=M200, concentration=CON)
+    a_arr = np.array([0.5, 1.])
+
+    n1 = p1.get_normalization_grid(COSMO, a_arr, hmc=hmc)
+    n2 = p2.get_normalization_grid(COSMO, a_arr, hmc=hmc)
+    assert np.allclose(n2, 2*n1, rtol=1E-10, atol=0)
+
+    b1 = ccl.halos.halomod_bias_1pt(COSMO, hmc, KK, a_arr, p1)
+    b2 = ccl.halos.halomod_bias_1pt(COSMO, hmc, KK, a_arr, p2)
+    assert np.allclose(b2, b1/2, rtol=1E-6, atol=0)
+
+    pk1 = ccl.halos.halomod_power_spectrum(COSMO, hmc, KK, a_arr, p1)
+    pk2 = ccl.halos.halomod_power_spectrum(COSMO, hmc, KK, a_arr, p2)
+    assert np.allclose(pk2, pk1/4, rtol=1E-6, atol=0)
+
+
 def test_pkhm_errors():
     # Wrong integration
     with pytest.raises(ValueError):
@@ -490,6 +490,54 @@ def test_input_nonlin_raises():
     assert cosmo_input.has_nonlin_power
 
 
+def test_input_shared_grid():
+    # Arrays on a common grid are ingested in bulk, and must give the
+    # same splines as the standard constructors.
+    cosmo = ccl.CosmologyVanillaLCDM(transfer_function='bbks')
+    a_arr = np.linspace(0.1, 1, 50)
+    k_arr = np.geomspace(1E-4, 1E1, 128)
+    background = {'a': a_arr,
+                  'chi': ccl.comoving_radial_distance(cosmo, a_arr),
+                  'h_over_h0': ccl.h_over_h0(cosmo, a_arr)}
+    growth = {'a': a_arr,
+              'growth_factor': ccl.growth_factor_unnorm(cosmo, a_arr),
+              'growth_rate': ccl.growth_rate(cosmo, a_arr)}
+    pkl = np.array([ccl.linear_matter_power(cosmo, k_arr, a) for a in a_arr])
+    pknl = np.array([ccl.nonlin_matter_power(cosmo, k_arr, a)
+                     for a in a_arr])
+    pars = dict(Omega_c=0.25, Omega_b=0.05, h=0.67, n_s=0.96, sigma8=0.81)
+
+    cosmo_bulk = ccl.CosmologyCalculator(
+        **pars, background=background, growth=growth,
+        pk_linear={'a': a_arr, 'k': k_arr,
+                   'delta_matter:delta_matter': pkl, 'a:b': -pkl},
+        pk_nonlin={'a': a_arr, 'k': k_arr,
+                   'delta_matter:delta_matter': pknl})
+    assert cosmo_bulk.has_distances and cosmo_bulk.has_growth
+
+    a = np.linspace(0.15, 0.95, 20)
+    assert np.allclose(ccl.comoving_radial_distance(cosmo_bulk, a),
+                       ccl.comoving_radial_distance(cosmo, a),
+                       atol=0, rtol=1E-5)
+    assert np.allclose(ccl.growth_factor(cosmo_bulk, a),
+                       ccl.growth_factor(cosmo, a), atol=0, rtol=1E-5)
+
+    lk_arr = np.log(k_arr)
+    for name, pk_dict, pk in [('delta_matter:delta_matter',
+                               cosmo_bulk._pk_lin, pkl),
+                              ('delta_matter:delta_matter',
+                               cosmo_bulk._pk_nl, pknl),
+                              ('a:b', cosmo_bulk._pk_lin, -pkl)]:
+        use_log = (pk > 0).all()
+        ref = ccl.Pk2D(a_arr=a_arr, lk_arr=lk_arr,
+                       pk_arr=np.log(pk) if use_log else pk,
+                       is_logp=use_log)
+        assert pk_dict[name].psp.is_log == use_log
+        _, _, pk_ref = ref.get_spline_arrays()
+        _, _, pk_bulk = pk_dict[name].get_spline_arrays()
+        assert np.allclose(pk_bulk, pk_ref, atol=0, rtol=1E-12)
+
+
 def test_camb_de_model():
     """Check that the dark energy model for CAMB has been properly defined."""
     with pytest.raises(ValueError):
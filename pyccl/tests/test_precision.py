@@ -0,0 +1,70 @@
+import numpy as np
+import pytest
+import pyccl as ccl
+
+
+def test_precision_profiles():
+    default = ccl.get_precision()
+    with ccl.precision_scope("fast"):
+        fast = ccl.get_precision()
+        cosmo = ccl.CosmologyVanillaLCDM(transfer_function="bbks")
+    assert ccl.get_precision() == default
+    # The submodule is not shadowed by any of its functions.
+    assert ccl.precision.PRECISION_PROFILES is ccl.PRECISION_PROFILES
+
+    prof = ccl.PRECISION_PROFILES["fast"]
+    for section in ["spline_params", "gsl_params"]:
+        for name, value in prof[section].items():
+            assert fast[section][name] == value
+    assert cosmo.cosmo.spline_params.A_SPLINE_NA == 120
+    assert cosmo.cosmo.gsl_params.INTEGRATION_LIMBER_EPSREL == 1E-3
+
+    # Fast cosmologies still agree with the default ones at 1e-3.
+    cosmo0 = ccl.CosmologyVanillaLCDM(transfer_function="bbks")
+    a = np.linspace(0.2, 1, 5)
+    assert np.allclose(cosmo.comoving_radial_distance(a),
+                       cosmo0.comoving_radial_distance(a), rtol=1E-4)
+    assert np.allclose(cosmo.linear_matter_power(0.1, 0.5),
+                       cosmo0.linear_matter_power(0.1, 0.5), rtol=1E-3)
+
+
+def test_precision_set_and_reset():
+    try:
+        ccl.set_precision("high")
+        assert ccl.spline_params.N_K == 334
+        assert ccl.gsl_params.ODE_GROWTH_EPSREL == 1E-8
+    finally:
+        ccl.set_precision("default")
+    assert ccl.spline_params.N_K == 167
+
+    with pytest.raises(KeyError):
+        ccl.set_precision({"other_params": {}})
+    with pytest.raises(TypeError):
+        ccl.set_precision(1)
+
+
+def test_precision_profile_io(tmp_path):
+    fname = str(tmp_path / "profile.yml")
+    ccl.write_precision_profile("fast", fname)
+    assert ccl.read_precision_profile(fname) == ccl.PRECISION_PROFILES["fast"]
+    with ccl.precision_scope(fname):
+        assert ccl.spline_params.A_SPLINE_NA_PK == 20
+
+
+def test_tune_precision(tmp_path):
+    fname = str(tmp_path / "tuned.yml")
+    cosmo = ccl.CosmologyVanillaLCDM(transfer_function="bbks")
+    targets = {"distances": 1E-4, "growth": 1E-4, "pk": 1E-2, "cls": 1E-2}
+    prof = ccl.tune_precision([cosmo], targets=targets, filename=fname)
+
+    val = prof["validation"]
+    assert val["targets"] == targets
+    for q, err in val["max_errors"].items():
+        assert err <= targets[q]
+    # Loose targets allow coarser settings than the reference.
+    high = ccl.PRECISION_PROFILES["high"]["spline_params"]
+    assert prof["spline_params"]["A_SPLINE_NA"] < high["A_SPLINE_NA"]
+    assert ccl.read_precision_profile(fname) == prof
+
+    with pytest.raises(KeyError):
+        ccl.tune_precision([cosmo], targets={"sigma8": 1E-3})
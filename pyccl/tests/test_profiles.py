@@ -165,6 +165,67 @@ def test_cib_smoke():
         assert getattr(p, n) == 1234.
 
 
+def test_cib_lumsat():
+    from scipy.integrate import quad
+    c = ccl.halos.ConcentrationDuffy08(mass_def='200c')
+    p = ccl.halos.HaloProfileCIBShang12(concentration=c, nu_GHz=217,
+                                        mass_def='200c')
+    a = 0.5
+    M = np.array([1E14, 1E9, 3E11, 1E13, 2E15])
+
+    def lumsat(m):
+        def integrand(lnm):
+            msub = np.exp(lnm)
+            return (p.dNsub_dlnM_TinkerWetzel10(msub, m) *
+                    p._Lum(np.log10(msub), a))
+        return quad(integrand, np.log(p.Mmin), np.log(m),
+                    epsrel=1E-8, limit=500)[0]
+
+    Ls = p._Lumsat(M, a)
+    assert Ls[1] == 0
+    Ls_pred = np.array([lumsat(m) for m in M[M > p.Mmin]])
+    assert np.allclose(Ls[M > p.Mmin], Ls_pred, rtol=1E-4, atol=0)
+    # Independent of the other masses requested
+    assert np.all(p._Lumsat(M[:1], a) == Ls[:1])
+
+    # Overridden subhalo mass functions are used by the table
+    class CIB2(ccl.halos.HaloProfileCIBShang12):
+        def dNsub_dlnM_TinkerWetzel10(self, Msub, Mparent):
+            return 2*super().dNsub_dlnM_TinkerWetzel10(Msub, Mparent)
+
+    p2 = CIB2(concentration=c, nu_GHz=217, mass_def='200c')
+    assert np.allclose(p2._Lumsat(M, a), 2*Ls, rtol=1E-10, atol=0)
+
+
+def test_cib_multifreq():
+    c = ccl.halos.ConcentrationDuffy08(mass_def='200c')
+    nus = np.array([150., 217., 353.])
+    profs = [ccl.halos.HaloProfileCIBShang12(concentration=c, nu_GHz=nu,
+                                             mass_def='200c')
+             for nu in nus]
+    p2pt = ccl.halos.Profile2ptCIB()
+    k = np.geomspace(1E-2, 10, 8)
+    M = np.geomspace(1E11, 1E15, 5)
+    a = 0.5
+
+    uk = profs[0].fourier_multifreq(COSMO, k, M, a, nus)
+    assert uk.shape == (3, 5, 8)
+    uk2 = profs[0].fourier_variance_multifreq(COSMO, k, M, a, nus)
+    assert uk2.shape == (3, 3, 5, 8)
+    for i1, p1 in enumerate(profs):
+        assert np.allclose(uk[i1], p1.fourier(COSMO, k, M, a),
+                           rtol=1E-12, atol=0)
+        for i2, p2 in enumerate(profs):
+            F = p2pt.fourier_2pt(COSMO, k, M, a, p1, prof2=p2)
+            assert np.allclose(uk2[i1, i2], F, rtol=1E-12, atol=0)
+
+    # Scalar inputs are squeezed out
+    p = profs[0]
+    assert p.fourier_multifreq(COSMO, 1., 1E13, a, 217.).shape == ()
+    assert p.fourier_multifreq(COSMO, k, 1E13, a, nus).shape == (3, 8)
+    assert p.fourier_variance_multifreq(COSMO, 1., M, a, 217.).shape == (5,)
+
+
 def test_cib_2pt_diag():
     c = ccl.halos.ConcentrationDuffy08(mass_def='200c')
     p1 = ccl.halos.HaloProfileCIBShang12(concentration=c, nu_GHz=217,
@@ -242,6 +303,31 @@ def test_gnfw_refourier():
     assert p_f1 != p_f2
 
 
+@pytest.mark.parametrize('x_out', [np.inf, 3.])
+def test_gnfw_fourier_accuracy(x_out):
+    from scipy.integrate import quad
+    p = ccl.halos.HaloProfilePressureGNFW(mass_def='200c', x_out=x_out)
+    q = np.geomspace(1E-2, 1E2, 16)
+
+    def integrand(x):
+        return p._form_factor(x)*x
+
+    f_pred = np.array([quad(integrand, a=1e-7, b=x_out, weight="sin",
+                            wvar=qq, limit=1000)[0] / qq
+                       for qq in q])
+    f = p._integ_interp()(np.log(q))
+    assert np.all(np.fabs(f - f_pred) < 1E-4 * f_pred[0])
+
+
+def test_gnfw_fourier_shared():
+    p1 = ccl.halos.HaloProfilePressureGNFW(mass_def='200c')
+    p2 = ccl.halos.HaloProfilePressureGNFW(mass_def='500c')
+    # Profiles with the same shape share the same template
+    assert p1._integ_interp() is p2._integ_interp()
+    p2.update_parameters(alpha=1.2)
+    assert p1._integ_interp() is not p2._integ_interp()
+
+
 def test_hod_smoke():
     prof_class = ccl.halos.HaloProfileHOD
     c = ccl.halos.ConcentrationDuffy08(mass_def='200c')
@@ -537,6 +623,29 @@ def test_hernquist_accuracy(use_analytic):
     assert np.all(res < tol)
 
 
+def test_hernquist_analytic_continuity():
+    # Closed forms switch to series expansions around R = r_s for the
+    # projected profiles and at k r_s = 40 for the Fourier profile.
+    cM = ccl.halos.ConcentrationDuffy08(mass_def='200c')
+    p = ccl.halos.HaloProfileHernquist(mass_def='200c', concentration=cM,
+                                       truncated=False)
+    M = np.array([1E13, 1E14])
+    a = 0.5
+    r_s = (cM.mass_def.get_radius(COSMO, M, a) / a) / cM(COSMO, M, a)
+    for r_s_i, M_i in zip(r_s, M):
+        for meth in ['_projected_analytic', '_cumul2d_analytic']:
+            f = getattr(p, meth)(COSMO, r_s_i * np.array(
+                [1-1E-8, 1, 1+1E-8]), M_i, a)
+            assert np.allclose(f[:2], f[1:], rtol=1E-7, atol=0)
+            # Smooth across the boundaries of the series expansion
+            f = getattr(p, meth)(COSMO, r_s_i * np.sqrt(
+                [0.9-1E-9, 0.9+1E-9, 1.1-1E-9, 1.1+1E-9]), M_i, a)
+            assert np.allclose(f[::2], f[1::2], rtol=1E-7, atol=0)
+        k = 40 * np.array([1-1E-9, 1+1E-9]) / r_s_i
+        fk = p._fourier_analytic(COSMO, k, M_i, a)
+        assert np.allclose(fk[0], fk[1], rtol=1E-7, atol=0)
+
+
 def test_hernquist_f2r():
     cM = ccl.halos.ConcentrationDuffy08(mass_def='200c')
     p1 = ccl.halos.HaloProfileHernquist(mass_def='200c',
@@ -634,6 +743,24 @@ def test_einasto_projected_accuracy():
     assert np.all(res2 < 6e-2)
 
 
+@pytest.mark.parametrize('alpha', ['cosmo', 0.25])
+def test_einasto_fourier_accuracy(alpha):
+    cM = ccl.halos.ConcentrationDuffy08(mass_def='200c')
+    p = ccl.halos.HaloProfileEinasto(mass_def='200c', concentration=cM,
+                                     alpha=alpha)
+    M = np.array([1E12, 1E14, 1E15])
+    k = np.geomspace(1E-3, 1E2, 64)
+    # Interpolated templates vs. direct FFTLog of the real-space profile
+    fk1 = p.fourier(COSMO, k, M, 0.5)
+    fk2 = p._fftlog_wrap(COSMO, k, M, 0.5, fourier_out=True)
+    assert np.all(np.fabs(fk1-fk2) < 1E-4 * fk2[:, :1])
+    # Templates are shared by profiles with the same alpha grid
+    p2 = ccl.halos.HaloProfileEinasto(mass_def='200c', concentration=cM,
+                                      truncated=False, alpha=alpha)
+    alpha_arr = p._get_alpha(COSMO, M, 0.5)
+    assert p._get_tables(alpha_arr) is p2._get_tables(alpha_arr)
+
+
 def test_HaloProfile_abstractmethods():
     # Test that `HaloProfile` and its subclasses can't be instantiated if
     # either `_real` or `_fourier` have not been defined.
@@ -1,3 +1,6 @@
+import numpy as np
+import pytest
+from scipy.special import spherical_jn
 import pyccl as ccl
 
 
@@ -9,3 +12,39 @@ def test_version():
 def test_debug_mode_toggle():
     ccl.debug_mode(True)
     ccl.debug_mode(False)
+
+
+@pytest.mark.parametrize("l_max", [0, 1, 10, 300])
+def test_spherical_bessel_jl(l_max):
+    x = np.concatenate([[0., 1E-9, -2.5],
+                        np.geomspace(1E-2, 1E4, 256),
+                        np.linspace(0.5, 1.5, 64)*l_max])
+    jl = ccl.spherical_bessel_jl(l_max, x)
+    assert jl.shape == (l_max+1, x.size)
+    assert not jl.flags.writeable
+
+    ls = np.arange(l_max+1)[:, None]
+    ref = spherical_jn(ls, x[None, :])
+    # Compare relative to the local amplitude of j_l(x), since the
+    # relative error is large close to its zeros.
+    amp = np.maximum(np.abs(ref), 1E-3/np.maximum(np.abs(x), ls+1))
+    assert np.all(np.fabs(jl-ref) < 1E-10*amp)
+
+    jl = ccl.spherical_bessel_jl(l_max, x[:321].reshape([-1, 3]))
+    assert jl.shape == (l_max+1, 107, 3)
+
+    with pytest.raises(ValueError):
+        ccl.spherical_bessel_jl(-1, x)
+
+
+def test_spherical_bessel_jl_cache():
+    x = np.geomspace(1E-2, 1E3, 128)
+    enabled = ccl.Caching._enabled
+    ccl.Caching.enable()
+    try:
+        jl1 = ccl.spherical_bessel_jl(20, x)
+        jl2 = ccl.spherical_bessel_jl(20, x.copy())
+        assert jl1 is jl2
+    finally:
+        if not enabled:
+            ccl.Caching.disable()
@@ -428,6 +428,29 @@ def test_tracer_chi_min_max():
     assert tr.chi_max == tr._trc[1].chi_max
 
 
+def test_tracer_collection_reused():
+    # The C-level collection is built once and reused, and rebuilt when
+    # more tracers are added.
+    z = np.linspace(0., 1., 64)
+    nz = np.exp(-0.5*((z-0.5)/0.1)**2)
+    tr = ccl.WeakLensingTracer(COSMO, dndz=(z, nz))
+    ell = np.geomspace(10, 1000, 8)
+    cl = ccl.angular_cl(COSMO, tr, tr, ell)
+    clt = tr._get_collection()
+    assert tr._get_collection() is clt
+    assert np.allclose(ccl.angular_cl(COSMO, tr, tr, ell), cl,
+                       atol=0, rtol=1E-12)
+    assert clt.chi_min == tr.chi_min
+    assert clt.chi_max == tr.chi_max
+
+    tr.add_tracer(COSMO, kernel=(np.linspace(100., 200., 32),
+                                 np.ones(32)))
+    clt2 = tr._get_collection()
+    assert clt2.n_tracers == 2
+    assert clt2.chi_min == tr.chi_min
+    assert not np.allclose(ccl.angular_cl(COSMO, tr, tr, ell), cl)
+
+
 def test_empty_wlnc_tracer():
     z = np.linspace(0, 1.0, 32)
     nz = np.exp(-0.5*((z-0.5)/0.05)**2)
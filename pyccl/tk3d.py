@@ -177,6 +177,11 @@ class Tk3D(CCLObject):
     def extrap_order_hik(self):
         return self.tsp.extrap_order_hik if self else None
 
+    @property
+    def nbytes(self):
+        """Number of bytes held by the C-level splines of this object."""
+        return lib.f3d_t_size(self.tsp) if self else 0
+
     def __call__(self, k, a):
         """Evaluate trispectrum. If ``k`` is a 1D array with size ``nk``, and
         ``a`` is a scalar, the output ``out`` will be a 2D array with shape
@@ -220,6 +220,7 @@ class Tracer(CCLObject):
         """
         # Do nothing, just initialize list of tracers
         self._trc = []
+        self._clt = None
         self.chi_fft_dict = {}
         self.avg_weighted_a = []
 
@@ -321,6 +322,36 @@ class Tracer(CCLObject):
         chis = [tr.chi_max for tr in self._trc]
         return max(chis) if chis else None
 
+    @unlock_instance(mutate=False)
+    def _get_collection(self):
+        """Returns the C-level collection holding all the tracers in this
+        object, together with their combined radial support. It is built
+        the first time it is needed and reused by all subsequent power
+        spectrum calls, unless more tracers have been added since.
+        """
+        if self._clt is not None and self._clt.n_tracers == len(self._trc):
+            return self._clt
+        if self._clt is not None:
+            lib.cl_tracer_collection_t_free(self._clt)
+            self._clt = None
+
+        status = 0
+        clt, status = lib.cl_tracer_collection_t_new(status)
+        for t in self._trc:
+            status = lib.add_cl_tracer_to_collection(clt, t, status)
+        if status:
+            lib.cl_tracer_collection_t_free(clt)
+        check(status)
+        self._clt = clt
+        return clt
+
+    @property
+    def nbytes(self):
+        """Number of bytes held by the C-level kernels and transfer
+        functions of all the tracers contained in this object.
+        """
+        return sum(lib.cl_tracer_t_size(tr) for tr in self._trc)
+
     def get_kernel(self, chi=None):
         """Get the radial kernels for all tracers contained
         in this ``Tracer``.
@@ -363,6 +394,38 @@ class Tracer(CCLObject):
             kernels = np.squeeze(kernels, axis=-1)
         return kernels
 
+    def with_kernels(self, cosmo, kernels):
+        """Create a new ``Tracer`` with the same transfer functions,
+        :math:`\\ell`-dependent prefactors and Bessel function derivatives
+        as this one, but different radial kernels. This is useful e.g. to
+        describe the derivatives of the radial kernels with respect to
+        model parameters (see :func:`~pyccl.cells.angular_cl_derivatives`).
+
+        Args:
+            cosmo (:class:`~pyccl.cosmology.Cosmology`): Cosmology object.
+            kernels (:obj:`list`): one ``(chi, w)`` tuple of arrays for each
+                tracer contained in this object, holding the values of the
+                comoving radial distance (in Mpc) and of the new kernel.
+
+        Returns:
+            :class:`Tracer`: new tracer.
+        """
+        if len(kernels) != len(self._trc):
+            raise ValueError("`kernels` must contain one (chi, w) pair for "
+                             f"each of the {len(self._trc)} tracers.")
+
+        tracer = Tracer()
+        for t, (chi, w) in zip(self._trc, kernels):
+            chi_s = np.atleast_1d(np.array(chi, dtype=float))
+            wchi_s = np.atleast_1d(np.array(w, dtype=float))
+            status = 0
+            tr, status = lib.cl_tracer_t_new_with_kernel_wrapper(
+                cosmo.cosmo, t, chi_s, wchi_s, status)
+            check(status, cosmo=cosmo)
+            tracer._trc.append(tr)
+        tracer.avg_weighted_a.extend(self.avg_weighted_a)
+        return tracer
+
     def get_f_ell(self, ell):
         """Get the :math:`\\ell`-dependent prefactors for all tracers
         contained in this `Tracer`.
@@ -750,6 +813,9 @@ class Tracer(CCLObject):
         # Sometimes lib is freed before some Tracers, in which case, this
         # doesn't work.
         # So just check that lib.cl_tracer_t_free is still a real function.
+        if getattr(self, '_clt', None) is not None and \
+                lib.cl_tracer_collection_t_free is not None:
+            lib.cl_tracer_collection_t_free(self._clt)
         if hasattr(self, '_trc') and lib.cl_tracer_t_free is not None:
             for t in self._trc:
                 lib.cl_tracer_t_free(t)
@@ -755,6 +755,22 @@ void ccl_cosmology_growth_from_input(ccl_cosmology* cosmo, int na, double a[],
   free(growth_normed);
 }
 
+/* ----- ROUTINE: ccl_cosmology_background_from_input ------
+INPUT: cosmology, scale factor array, comoving distance, E(a), growth factor
+       and growth rate arrays, all sampled at the same scale factors
+TASK: build the distance and growth splines from a single set of input arrays
+*/
+void ccl_cosmology_background_from_input(ccl_cosmology *cosmo, int na, double a[],
+                                         double chi_a[], double E_a[],
+                                         double growth_arr[], double fgrowth_arr[],
+                                         int *status)
+{
+  // The ordering of a is validated by the caller and by gsl_spline_init.
+  ccl_cosmology_distances_from_input(cosmo, na, a, chi_a, E_a, status);
+  if(*status == 0)
+    ccl_cosmology_growth_from_input(cosmo, na, a, growth_arr, fgrowth_arr, status);
+}
+
 /* ----- ROUTINE: ccl_cosmology_compute_growth ------
 INPUT: cosmology
 TASK: if not already there, make a table of growth function and growth rate
@@ -1402,3 +1418,156 @@ void ccl_growth_rates(ccl_cosmology * cosmo, int na, double a[], double output[]
     *status |= _status;
   }
 }
+
+/* ----- ROUTINE: ccl_cosmology_compute_halo_background ------
+INPUT: cosmology
+TASK: tabulate the background quantities used by halo-model ingredients,
+      i.e. Omega_m(a) and the virial overdensity Delta_vir(a), on the same
+      scale factor grid as the distance splines.
+*/
+void ccl_cosmology_compute_halo_background(ccl_cosmology *cosmo, int *status)
+{
+  if(cosmo->computed_halo_background)
+    return;
+
+  int na = cosmo->spline_params.A_SPLINE_NA+cosmo->spline_params.A_SPLINE_NLOG-1;
+  double *a = ccl_linlog_spacing(
+    cosmo->spline_params.A_SPLINE_MINLOG, cosmo->spline_params.A_SPLINE_MIN,
+    cosmo->spline_params.A_SPLINE_MAX, cosmo->spline_params.A_SPLINE_NLOG,
+    cosmo->spline_params.A_SPLINE_NA);
+  double *Om_a = malloc(sizeof(double)*na);
+  double *Dv_a = malloc(sizeof(double)*na);
+  gsl_spline *Om = gsl_spline_alloc(cosmo->spline_params.A_SPLINE_TYPE, na);
+  gsl_spline *Dv = gsl_spline_alloc(cosmo->spline_params.A_SPLINE_TYPE, na);
+
+  if(a == NULL || Om_a == NULL || Dv_a == NULL || Om == NULL || Dv == NULL) {
+    *status = CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(
+      cosmo, "ccl_background.c: ccl_cosmology_compute_halo_background(): ran out of memory\n");
+  }
+
+  if(!*status) {
+    for(int i=0; i<na; i++) {
+      double x;
+      Om_a[i] = ccl_omega_x(cosmo, a[i], ccl_species_m_label, status);
+      // Bryan & Norman 1998, Eq. 6
+      x = Om_a[i]-1;
+      Dv_a[i] = 18*M_PI*M_PI+82*x-39*x*x;
+    }
+  }
+
+  if(!*status) {
+    if(gsl_spline_init(Om, a, Om_a, na) || gsl_spline_init(Dv, a, Dv_a, na)) {
+      *status = CCL_ERROR_SPLINE;
+      ccl_cosmology_set_status_message(
+        cosmo, "ccl_background.c: ccl_cosmology_compute_halo_background(): Error creating splines\n");
+    }
+  }
+
+  free(a);
+  free(Om_a);
+  free(Dv_a);
+  if(*status) {
+    gsl_spline_free(Om);
+    gsl_spline_free(Dv);
+    return;
+  }
+
+  cosmo->data.Om = Om;
+  cosmo->data.Delta_vir = Dv;
+  cosmo->computed_halo_background = true;
+}
+
+// Look up a halo background spline, computing the quantity directly
+// outside of the range of the spline.
+static double halo_background_eval(ccl_cosmology *cosmo, gsl_spline *spl,
+                                   double a, int is_Dv, int *status)
+{
+  double x, y;
+
+  if(!cosmo->computed_halo_background) {
+    *status = CCL_ERROR_HALO_BACKGROUND_INIT;
+    ccl_cosmology_set_status_message(
+      cosmo,
+      "ccl_background.c: halo background splines have not been precomputed!");
+    return NAN;
+  }
+
+  if((a >= spl->x[0]) && (a <= spl->x[spl->size-1]))
+    return gsl_spline_eval(spl, a, NULL);
+
+  y = ccl_omega_x(cosmo, a, ccl_species_m_label, status);
+  if(is_Dv) {
+    x = y-1;
+    y = 18*M_PI*M_PI+82*x-39*x*x;
+  }
+  return y;
+}
+
+double ccl_Delta_vir(ccl_cosmology *cosmo, double a, ccl_species_x_label label, int *status)
+{
+  double Dv = halo_background_eval(cosmo, cosmo->data.Delta_vir, a, 1, status);
+
+  switch(label) {
+    case ccl_species_crit_label :
+      return Dv;
+    case ccl_species_m_label :
+      return Dv/halo_background_eval(cosmo, cosmo->data.Om, a, 0, status);
+    default:
+      *status = CCL_ERROR_PARAMETERS;
+      ccl_cosmology_set_status_message(
+        cosmo, "ccl_background.c: ccl_Delta_vir(): Species %d not supported\n", label);
+      return NAN;
+  }
+}
+
+void ccl_Delta_virs(ccl_cosmology *cosmo, int na, double a[], ccl_species_x_label label,
+                    double output[], int *status)
+{
+  int _status;
+
+  for (int i=0; i<na; i++) {
+    _status = 0;
+    output[i] = ccl_Delta_vir(cosmo, a[i], label, &_status);
+    *status |= _status;
+  }
+}
+
+double ccl_delta_c(ccl_cosmology *cosmo, double a, ccl_delta_c_t kind,
+                   double sigma8, int *status)
+{
+  // Linear collapse threshold in Einstein de-Sitter: 3/20*(12*pi)^(2/3)
+  const double dc0 = 1.68647019984;
+  double Om;
+
+  switch(kind) {
+    case ccl_delta_c_EdS :
+      return dc0;
+    case ccl_delta_c_EdS_approx :
+      return 1.686;
+    case ccl_delta_c_NakamuraSuto97 :
+      Om = halo_background_eval(cosmo, cosmo->data.Om, a, 0, status);
+      return dc0*(1+0.012299*log10(Om));
+    case ccl_delta_c_Mead16 :
+      Om = halo_background_eval(cosmo, cosmo->data.Om, a, 0, status);
+      return ((1.59+0.0314*log(sigma8*ccl_growth_factor(cosmo, a, status))) *
+              (1+0.0123*log10(Om)));
+    default:
+      *status = CCL_ERROR_PARAMETERS;
+      ccl_cosmology_set_status_message(
+        cosmo, "ccl_background.c: ccl_delta_c(): threshold kind %d not supported\n", kind);
+      return NAN;
+  }
+}
+
+void ccl_delta_cs(ccl_cosmology *cosmo, int na, double a[], ccl_delta_c_t kind,
+                  double sigma8, double output[], int *status)
+{
+  int _status;
+
+  for (int i=0; i<na; i++) {
+    _status = 0;
+    output[i] = ccl_delta_c(cosmo, a[i], kind, sigma8, &_status);
+    *status |= _status;
+  }
+}
@@ -3,13 +3,19 @@
 #include <math.h>
 #include <string.h>
 
+#include <gsl/gsl_blas.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_integration.h>
 
 #include "ccl.h"
 
+// Relative step in chi used to differentiate the radial functions of the
+// extended Limber approximation.
+#define EXTLIMBER_DLNCHI 0.01
+
 typedef struct{
   double l;
+  int order;
   ccl_cosmology *cosmo;
   ccl_cl_tracer_collection_t *trc1;
   ccl_cl_tracer_collection_t *trc2;
@@ -37,27 +43,17 @@ static void update_chi_limits(ccl_cl_tracer_collection_t *trc,
                               double *chimin, double *chimax,
                               int is_union)
 {
-  int itr;
-  double chimin_h=1E15;
-  double chimax_h=-1E15;
-  for(itr=0; itr < trc->n_tracers; itr++) {
-    if (trc->ts[itr]->chi_min < chimin_h)
-      chimin_h = trc->ts[itr]->chi_min;
-    if (trc->ts[itr]->chi_max > chimax_h)
-      chimax_h = trc->ts[itr]->chi_max;
-  }
-
   if(is_union) {
-    if(chimin_h < *chimin)
-      *chimin = chimin_h;
-    if(chimax_h > *chimax)
-      *chimax = chimax_h;
+    if(trc->chi_min < *chimin)
+      *chimin = trc->chi_min;
+    if(trc->chi_max > *chimax)
+      *chimax = trc->chi_max;
   }
   else {
-    if(chimin_h > *chimin)
-      *chimin = chimin_h;
-    if(chimax_h < *chimax)
-      *chimax = chimax_h;
+    if(trc->chi_min > *chimin)
+      *chimin = trc->chi_min;
+    if(trc->chi_max < *chimax)
+      *chimax = trc->chi_max;
   }
 }
 
@@ -65,31 +61,10 @@ static void get_k_interval(ccl_cosmology *cosmo,
                            ccl_cl_tracer_collection_t *trc1,
                            ccl_cl_tracer_collection_t *trc2,
                            double l, double *lkmin, double *lkmax) {
-  int itr;
-
-  // Loop through all tracers and find distance bounds
-  double chi_min1 = 1E15;
-  double chi_max1 = -1E15;
-  for (itr=0; itr < trc1->n_tracers; itr++) {
-    if (trc1->ts[itr]->chi_min < chi_min1)
-      chi_min1 = trc1->ts[itr]->chi_min;
-    if (trc1->ts[itr]->chi_max > chi_max1)
-      chi_max1 = trc1->ts[itr]->chi_max;
-  }
-
-  double chi_min2 = 1E15;
-  double chi_max2 = -1E15;
-  for (itr=0; itr < trc2->n_tracers; itr++) {
-    if (trc2->ts[itr]->chi_min < chi_min2)
-      chi_min2 = trc2->ts[itr]->chi_min;
-    if (trc2->ts[itr]->chi_max > chi_max2)
-      chi_max2 = trc2->ts[itr]->chi_max;
-  }
-
   // Find maximum of minima and minimum of maxima
   // (i.e. edges where the product of both kernels will have support).
-  double chi_min = fmax(chi_min1, chi_min2);
-  double chi_max = fmin(chi_max1, chi_max2);
+  double chi_min = fmax(trc1->chi_min, trc2->chi_min);
+  double chi_max = fmin(trc1->chi_max, trc2->chi_max);
 
   if (chi_min <= 0)
     chi_min = 0.5*(l+0.5)/cosmo->spline_params.K_MAX;
@@ -162,7 +137,98 @@ static double transfer_limber_wrap(double l,double lk, double k, double chi,
   }
   return transfer;
 }
-      
+
+/* ------- ROUTINE: transfer_limber_ext_f ------
+INPUTS: multipole, wavenumber, comoving distance, tracer collection
+TASK: evaluate the radial function F(chi) = sum_i K_i(chi) T_i(k,chi)
+      sqrt(|P(k,chi)|/chi) at fixed k, whose chi-derivatives enter the
+      extended Limber approximation. Only contributions without Bessel
+      derivatives are included.
+*/
+static double transfer_limber_ext_f(double l, double lk, double k,
+                                    double chi,
+                                    ccl_cl_tracer_collection_t *trc,
+                                    ccl_cosmology *cosmo, ccl_f2d_t *psp,
+                                    int *status) {
+  int itr;
+  double a, f = 0;
+
+  // Outside of the distance splines
+  if ((chi <= 0) || (chi >= cosmo->data.achi->interp->xmax))
+    return 0;
+
+  a = ccl_scale_factor_of_chi(cosmo, chi, status);
+  for (itr=0; itr < trc->n_tracers; itr++) {
+    ccl_cl_tracer_t *tr = trc->ts[itr];
+    double dd;
+
+    if ((tr->der_bessel >= 1) || (chi < tr->chi_min) || (chi > tr->chi_max))
+      continue;
+    dd = (ccl_cl_tracer_t_get_kernel(tr, chi, status) *
+          ccl_cl_tracer_t_get_transfer(tr, lk, a, status) *
+          ccl_cl_tracer_t_get_f_ell(tr, l, status));
+    if (tr->der_bessel == -1) // j_l(k chi)/(k chi)^2
+      dd /= (k*chi)*(k*chi);
+    f += dd;
+  }
+  if (f == 0)
+    return 0;
+
+  return f*sqrt(fabs(ccl_f2d_t_eval(psp, lk, a, cosmo, status))/chi);
+}
+
+/* ------- ROUTINE: transfer_limber_ext ------
+INPUTS: multipole, wavenumber, comoving distance chi=(l+1/2)/k and scale
+        factor there, tracer collection
+TASK: compute the equivalent of transfer_limber_wrap including the
+      second-order extended Limber correction of LoVerde & Afshordi 2008:
+        int dx F(x) J_nu(k x) = [F - chi^2 (F_2 + chi F_3/3) / (2 nu^2)] / k,
+      where nu=l+1/2, F_n is the n-th derivative of F, and everything is
+      evaluated at chi=nu/k. The square root of the power spectrum is
+      folded into F, so that its time dependence is also accounted for.
+      Contributions with Bessel derivatives keep their leading-order form.
+*/
+static double transfer_limber_ext(double l, double lk, double k, double chi,
+                                  double a, ccl_cl_tracer_collection_t *trc,
+                                  ccl_cosmology *cosmo, ccl_f2d_t *psp,
+                                  int *status) {
+  int itr, i;
+  double f[5];
+  double transfer = 0;
+  double lp1h = l+0.5;
+  double h = EXTLIMBER_DLNCHI*chi;
+  double pk = fabs(ccl_f2d_t_eval(psp, lk, a, cosmo, status));
+
+  for (itr=0; itr < trc->n_tracers; itr++) {
+    if (trc->ts[itr]->der_bessel >= 1)
+      transfer += transfer_limber_single(trc->ts[itr], l, lk, k, chi, a,
+                                         cosmo, psp, 0, status);
+  }
+  if ((pk == 0) || (*status != 0))
+    return transfer;
+
+  // Five-point stencils for the second and third derivatives
+  for (i=0; i < 5; i++)
+    f[i] = transfer_limber_ext_f(l, lk, k, chi+(i-2)*h, trc,
+                                 cosmo, psp, status);
+  double d2f = (-f[0]+16*f[1]-30*f[2]+16*f[3]-f[4])/(12*h*h);
+  double d3f = (-f[0]+2*f[1]-2*f[3]+f[4])/(2*h*h*h);
+  double fext = f[2] - chi*chi*(d2f+chi*d3f/3)/(2*lp1h*lp1h);
+
+  // Undo the sqrt(|P|/chi) factor, so this can be used as in cl_integrand
+  return transfer + fext*sqrt(chi/pk);
+}
+
+static double transfer_limber_order(integ_cl_par *p, double lk, double k,
+                                    double chi, double a,
+                                    ccl_cl_tracer_collection_t *trc) {
+  if (p->order == 2)
+    return transfer_limber_ext(p->l, lk, k, chi, a, trc,
+                               p->cosmo, p->psp, p->status);
+  return transfer_limber_wrap(p->l, lk, k, chi, a, trc,
+                              p->cosmo, p->psp, 0, p->status);
+}
+
 static double cl_integrand(double lk, void *params) {
   double d1, d2;
   integ_cl_par *p = (integ_cl_par *)params;
@@ -170,13 +236,11 @@ static double cl_integrand(double lk, void *params) {
   double chi = (p->l+0.5)/k;
   double a = ccl_scale_factor_of_chi(p->cosmo, chi, p->status);
 
-  d1 = transfer_limber_wrap(p->l, lk, k, chi, a, p->trc1,
-                            p->cosmo, p->psp, 0, p->status);
+  d1 = transfer_limber_order(p, lk, k, chi, a, p->trc1);
   if (d1 == 0)
     return 0;
 
-  d2 = transfer_limber_wrap(p->l, lk, k, chi, a, p->trc2,
-                            p->cosmo, p->psp, 0, p->status);
+  d2 = transfer_limber_order(p, lk, k, chi, a, p->trc2);
 
   if (d2 == 0)
     return 0;
@@ -193,19 +257,18 @@ static void integ_cls_limber_spline(ccl_cosmology *cosmo,
   int ik;
   int nk = (int)(fmax((lkmax - lkmin) / cosmo->spline_params.DLOGK_INTEGRATION + 0.5,
 		      1))+1;
-  double *fk_arr = NULL;
-  double *lk_arr = NULL;
-  lk_arr = ccl_linear_spacing(lkmin, lkmax, nk);
-  if(lk_arr == NULL)
-    *status = CCL_ERROR_LOGSPACE;
+  double dlk = (lkmax - lkmin) / (nk - 1.);
+  // Scratch arrays come from the thread's pool, as this runs once per ell
+  double *lk_arr = ccl_workspace_get_doubles(nk);
+  double *fk_arr = ccl_workspace_get_doubles(nk);
+  if((lk_arr == NULL) || (fk_arr == NULL))
+    *status = CCL_ERROR_MEMORY;
 
   if(*status == 0) {
-    fk_arr = malloc(nk * sizeof(double));
-    if(fk_arr == NULL)
-      *status = CCL_ERROR_MEMORY;
-  }
+    for(ik=0; ik<nk; ik++)
+      lk_arr[ik] = lkmin + dlk*ik;
+    lk_arr[nk-1] = lkmax;
 
-  if(*status == 0) {
     for(ik=0; ik<nk; ik++) {
       fk_arr[ik] = cl_integrand(lk_arr[ik], ipar);
       if(*(ipar->status)) {
@@ -220,8 +283,8 @@ static void integ_cls_limber_spline(ccl_cosmology *cosmo,
                      1, -1, result, gsl_interp_akima,
                      status);
   }
-  free(fk_arr);
-  free(lk_arr);
+  ccl_workspace_put_doubles(fk_arr);
+  ccl_workspace_put_doubles(lk_arr);
 }
 
 static void integ_cls_limber_qag_quad(ccl_cosmology *cosmo,
@@ -246,7 +309,7 @@ static void integ_cls_limber_qag_quad(ccl_cosmology *cosmo,
     ccl_raise_gsl_warning(gslstatus,
 			  "ccl_cls.c: integ_cls_limber_qag_quad(): "
 			  "Default GSL integration failure, attempting backup method.");
-    w_cquad = gsl_integration_cquad_workspace_alloc(cosmo->gsl_params.N_ITERATION);
+    w_cquad = ccl_workspace_get_cquad(cosmo->gsl_params.N_ITERATION);
     if (w_cquad == NULL)
       *status = CCL_ERROR_MEMORY;
 
@@ -257,18 +320,59 @@ static void integ_cls_limber_qag_quad(ccl_cosmology *cosmo,
 					w_cquad, result, eresult, &nevals);
     }
   }
-  gsl_integration_cquad_workspace_free(w_cquad);
+  ccl_workspace_put_cquad(w_cquad);
   if(*status == 0)
     *status = gslstatus;
 }
 
-void ccl_angular_cls_limber(ccl_cosmology *cosmo,
-			    ccl_cl_tracer_collection_t *trc1,
-			    ccl_cl_tracer_collection_t *trc2,
-			    ccl_f2d_t *psp,
-			    int nl_out, double *l_out, double *cl_out,
-			    ccl_integration_t integration_method,
-			    int *status) {
+/* ------- ROUTINE: integ_cls_limber_ell ------
+INPUTS: integrand parameters holding the cosmology, tracers and power
+        spectrum, multipole, integration method, QAG workspace
+TASK: compute the Limber power spectrum at a single multipole
+*/
+static double integ_cls_limber_ell(integ_cl_par *ipar, double l,
+                                   ccl_integration_t integration_method,
+                                   gsl_integration_workspace *w,
+                                   int *status) {
+  int clastatus = 0;
+  double lkmin, lkmax, result = 0, eresult;
+  gsl_function F;
+
+  ipar->l = l;
+  ipar->status = &clastatus;
+
+  // Get integration limits
+  get_k_interval(ipar->cosmo, ipar->trc1, ipar->trc2, l, &lkmin, &lkmax);
+
+  // Integrate
+  if(integration_method == ccl_integration_qag_quad) {
+    F.function = &cl_integrand;
+    F.params = ipar;
+    integ_cls_limber_qag_quad(ipar->cosmo, &F, lkmin, lkmax, w,
+                              &result, &eresult, status);
+  }
+  else if(integration_method == ccl_integration_spline) {
+    integ_cls_limber_spline(ipar->cosmo, ipar, lkmin, lkmax,
+                            &result, status);
+  }
+  else
+    *status = CCL_ERROR_NOT_IMPLEMENTED;
+
+  if ((clastatus == 0) && (*status == 0))
+    return result / (l+0.5);
+
+  ccl_raise_gsl_warning(*status, "ccl_cls.c: ccl_angular_cls_limber():");
+  *status = CCL_ERROR_INTEG;
+  return NAN;
+}
+
+static void angular_cls_limber(ccl_cosmology *cosmo,
+                               ccl_cl_tracer_collection_t *trc1,
+                               ccl_cl_tracer_collection_t *trc2,
+                               ccl_f2d_t *psp,
+                               int nl_out, double *l_out, double *cl_out,
+                               ccl_integration_t integration_method,
+                               int order, int *status) {
 
   // make sure to init core things for safety
   if (!cosmo->computed_distances) {
@@ -280,74 +384,1000 @@ void ccl_angular_cls_limber(ccl_cosmology *cosmo,
   }
 
   #pragma omp parallel shared(cosmo, trc1, trc2, l_out, cl_out, \
-                              nl_out, status, psp, integration_method) \
+                              nl_out, status, psp, integration_method, \
+                              order) \
                        default(none)
   {
-    int clastatus, lind;
+    int lind;
     integ_cl_par ipar;
     gsl_integration_workspace *w = NULL;
     int local_status = *status;
-    gsl_function F;
-    double lkmin, lkmax, l, result, eresult;
 
-    if (local_status == 0) {
-      // Set up integrating function parameters
-      ipar.cosmo = cosmo;
-      ipar.trc1 = trc1;
-      ipar.trc2 = trc2;
-      ipar.psp = psp;
-      ipar.status = &clastatus;
+    // Set up integrating function parameters
+    ipar.order = order;
+    ipar.cosmo = cosmo;
+    ipar.trc1 = trc1;
+    ipar.trc2 = trc2;
+    ipar.psp = psp;
+
+    if((integration_method == ccl_integration_qag_quad) &&
+       (local_status == 0)) {
+      w = ccl_workspace_get_integration(cosmo->gsl_params.N_ITERATION);
+      if (w == NULL)
+        local_status = CCL_ERROR_MEMORY;
     }
 
-    if(integration_method == ccl_integration_qag_quad) {
+    #pragma omp for schedule(dynamic)
+    for (lind=0; lind < nl_out; ++lind) {
       if (local_status == 0) {
-	w = gsl_integration_workspace_alloc(cosmo->gsl_params.N_ITERATION);
-	if (w == NULL) {
-	  local_status = CCL_ERROR_MEMORY;
-	}
+        cl_out[lind] = integ_cls_limber_ell(&ipar, l_out[lind],
+                                            integration_method, w,
+                                            &local_status);
       }
+    }
+
+    ccl_workspace_put_integration(w);
+    ccl_workspace_release();
+
+    if (local_status) {
+      #pragma omp atomic write
+      *status = local_status;
+    }
+  }
+
+  if (*status) {
+    ccl_cosmology_set_status_message(
+      cosmo,
+      "ccl_cls.c: ccl_angular_cls_limber(); integration error\n");
+  }
+}
+
+void ccl_angular_cls_limber(ccl_cosmology *cosmo,
+			    ccl_cl_tracer_collection_t *trc1,
+			    ccl_cl_tracer_collection_t *trc2,
+			    ccl_f2d_t *psp,
+			    int nl_out, double *l_out, double *cl_out,
+			    ccl_integration_t integration_method,
+			    int *status) {
+  angular_cls_limber(cosmo, trc1, trc2, psp, nl_out, l_out, cl_out,
+                     integration_method, 1, status);
+}
+
+void ccl_angular_cls_limber_extended(ccl_cosmology *cosmo,
+                                     ccl_cl_tracer_collection_t *trc1,
+                                     ccl_cl_tracer_collection_t *trc2,
+                                     ccl_f2d_t *psp,
+                                     int nl_out, double *l_out,
+                                     double *cl_out,
+                                     ccl_integration_t integration_method,
+                                     int *status) {
+  angular_cls_limber(cosmo, trc1, trc2, psp, nl_out, l_out, cl_out,
+                     integration_method, 2, status);
+}
+
+ccl_cl_batch_t *ccl_cl_batch_t_new(int *status) {
+  ccl_cl_batch_t *batch = NULL;
+  batch = malloc(sizeof(ccl_cl_batch_t));
+  if (batch == NULL)
+    *status = CCL_ERROR_MEMORY;
+
+  if (*status == 0) {
+    batch->n_cl = 0;
+    batch->cosmo = malloc(CCL_MAX_CL_BATCH*sizeof(ccl_cosmology *));
+    batch->trc1 = malloc(CCL_MAX_CL_BATCH*sizeof(ccl_cl_tracer_collection_t *));
+    batch->trc2 = malloc(CCL_MAX_CL_BATCH*sizeof(ccl_cl_tracer_collection_t *));
+    batch->psp = malloc(CCL_MAX_CL_BATCH*sizeof(ccl_f2d_t *));
+    if ((batch->cosmo == NULL) || (batch->trc1 == NULL) ||
+        (batch->trc2 == NULL) || (batch->psp == NULL)) {
+      *status = CCL_ERROR_MEMORY;
+      ccl_cl_batch_t_free(batch);
+      batch = NULL;
+    }
+  }
+
+  return batch;
+}
+
+void ccl_cl_batch_t_free(ccl_cl_batch_t *batch) {
+  if (batch != NULL) {
+    free(batch->cosmo);
+    free(batch->trc1);
+    free(batch->trc2);
+    free(batch->psp);
+    free(batch);
+  }
+}
+
+void ccl_add_cl_batch(ccl_cl_batch_t *batch,
+                      ccl_cosmology *cosmo,
+                      ccl_cl_tracer_collection_t *trc1,
+                      ccl_cl_tracer_collection_t *trc2,
+                      ccl_f2d_t *psp, int *status) {
+  if (batch->n_cl >= CCL_MAX_CL_BATCH) {
+    *status = CCL_ERROR_MEMORY;
+    return;
+  }
+  batch->cosmo[batch->n_cl] = cosmo;
+  batch->trc1[batch->n_cl] = trc1;
+  batch->trc2[batch->n_cl] = trc2;
+  batch->psp[batch->n_cl] = psp;
+  batch->n_cl++;
+}
+
+/* ------- ROUTINE: ccl_angular_cls_limber_batch ------
+INPUTS: batch of (cosmology, tracers, power spectrum) sets, multipoles,
+        output array, integration method
+TASK: compute the Limber power spectra of all sets in a single parallel
+      region, distributing (set, multipole) pairs over threads
+*/
+void ccl_angular_cls_limber_batch(ccl_cl_batch_t *batch,
+                                  int nl_out, double *l_out,
+                                  double *cl_out,
+                                  ccl_integration_t integration_method,
+                                  int *status) {
+  int ic;
+  int n_cl = batch->n_cl;
+  size_t n_iter = 0;
 
+  // make sure to init core things for safety
+  for (ic=0; ic < n_cl; ic++) {
+    ccl_cosmology *cosmo = batch->cosmo[ic];
+    if (!cosmo->computed_distances) {
+      *status = CCL_ERROR_DISTANCES_INIT;
+      ccl_cosmology_set_status_message(
+        cosmo,
+        "ccl_cls.c: ccl_angular_cls_limber_batch(): distance splines have not been precomputed!");
+      return;
+    }
+    // One workspace per thread must fit every cosmology
+    if (cosmo->gsl_params.N_ITERATION > n_iter)
+      n_iter = cosmo->gsl_params.N_ITERATION;
+  }
+
+  #pragma omp parallel shared(batch, l_out, cl_out, nl_out, n_cl, \
+                              n_iter, status, integration_method) \
+                       default(none)
+  {
+    int icl, ic;
+    integ_cl_par ipar;
+    gsl_integration_workspace *w = NULL;
+    int local_status = *status;
+
+    ipar.order = 1;
+
+    if((integration_method == ccl_integration_qag_quad) &&
+       (local_status == 0)) {
+      w = ccl_workspace_get_integration(n_iter);
+      if (w == NULL)
+        local_status = CCL_ERROR_MEMORY;
+    }
+
+    #pragma omp for schedule(dynamic)
+    for (icl=0; icl < n_cl*nl_out; ++icl) {
       if (local_status == 0) {
-	// Set up integrating function
-	F.function = &cl_integrand;
-	F.params = &ipar;
+        ic = icl / nl_out;
+        ipar.cosmo = batch->cosmo[ic];
+        ipar.trc1 = batch->trc1[ic];
+        ipar.trc2 = batch->trc2[ic];
+        ipar.psp = batch->psp[ic];
+        cl_out[icl] = integ_cls_limber_ell(&ipar, l_out[icl % nl_out],
+                                           integration_method, w,
+                                           &local_status);
+      }
+    }
+
+    ccl_workspace_put_integration(w);
+    ccl_workspace_release();
+
+    if (local_status) {
+      #pragma omp atomic write
+      *status = local_status;
+    }
+  }
+
+  if (*status) {
+    for (ic=0; ic < n_cl; ic++) {
+      ccl_cosmology_set_status_message(
+        batch->cosmo[ic],
+        "ccl_cls.c: ccl_angular_cls_limber_batch(); integration error\n");
+    }
+  }
+}
+
+/* ------- ROUTINE: ccl_bandpowers_t_new ------
+INPUTS: number of bandpowers, bandpower windows in compressed sparse row
+        format (row pointers, integer multipoles and weights of the
+        non-zero entries), number of multipoles to sample
+TASK: find the multipoles at which power spectra must be computed to
+      predict the bandpowers, and the windows projected onto them
+*/
+ccl_bandpowers_t *ccl_bandpowers_t_new(int n_bpw, int *bpw_start,
+                                       int *ell_nz, double *w_nz,
+                                       int n_sample, int *status) {
+  int ib, inz, il, is;
+  int n_nz, l_min, l_max, n_support;
+  int *support_index = NULL;
+  double *x_support = NULL;
+  ccl_bandpowers_t *bpw = NULL;
+
+  if ((n_bpw <= 0) || (bpw_start[0] != 0) ||
+      ((n_sample > 0) && (n_sample < 4))) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return NULL;
+  }
+  for (ib=0; ib < n_bpw; ib++) {
+    if (bpw_start[ib+1] < bpw_start[ib]) {
+      *status = CCL_ERROR_INCONSISTENT;
+      return NULL;
+    }
+  }
+  n_nz = bpw_start[n_bpw];
+  if (n_nz <= 0) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return NULL;
+  }
+
+  // Range of multipoles covered by the windows
+  l_min = ell_nz[0];
+  l_max = ell_nz[0];
+  for (inz=0; inz < n_nz; inz++) {
+    if (ell_nz[inz] < 0) {
+      *status = CCL_ERROR_INCONSISTENT;
+      return NULL;
+    }
+    if (ell_nz[inz] < l_min)
+      l_min = ell_nz[inz];
+    if (ell_nz[inz] > l_max)
+      l_max = ell_nz[inz];
+  }
+
+  // Position of each multipole of [l_min, l_max] within the support
+  support_index = malloc((l_max-l_min+1)*sizeof(int));
+  if (support_index == NULL) {
+    *status = CCL_ERROR_MEMORY;
+    return NULL;
+  }
+  for (il=0; il <= l_max-l_min; il++)
+    support_index[il] = -1;
+  for (inz=0; inz < n_nz; inz++)
+    support_index[ell_nz[inz]-l_min] = 0;
+  n_support = 0;
+  for (il=0; il <= l_max-l_min; il++) {
+    if (support_index[il] >= 0)
+      support_index[il] = n_support++;
+  }
+
+  bpw = malloc(sizeof(ccl_bandpowers_t));
+  if (bpw == NULL)
+    *status = CCL_ERROR_MEMORY;
+
+  if (*status == 0) {
+    bpw->n_bpw = n_bpw;
+    if ((n_sample <= 0) || (n_sample >= n_support))
+      bpw->n_ell = n_support;
+    else
+      bpw->n_ell = n_sample;
+    bpw->ell = malloc(bpw->n_ell*sizeof(double));
+    bpw->w = calloc(n_bpw*bpw->n_ell, sizeof(double));
+    if ((bpw->ell == NULL) || (bpw->w == NULL))
+      *status = CCL_ERROR_MEMORY;
+  }
+
+  if ((*status == 0) && (bpw->n_ell == n_support)) {
+    // Every multipole in the support is computed
+    for (il=0; il <= l_max-l_min; il++) {
+      if (support_index[il] >= 0)
+        bpw->ell[support_index[il]] = l_min+il;
+    }
+    for (ib=0; ib < n_bpw; ib++) {
+      for (inz=bpw_start[ib]; inz < bpw_start[ib+1]; inz++)
+        bpw->w[ib*bpw->n_ell+support_index[ell_nz[inz]-l_min]] += w_nz[inz];
+    }
+  }
+  else if (*status == 0) {
+    // The power spectra are sampled at n_sample multipoles, evenly spaced
+    // in log(l+1), and interpolated onto the support with a cubic spline.
+    // The interpolation is linear in the sampled values, so it can be
+    // absorbed into the windows by interpolating each unit vector.
+    double x_min = log(l_min+1.), x_max = log(l_max+1.);
+    double *x_nodes = NULL, *y_nodes = NULL, *b_support = NULL;
+    gsl_interp *intp = NULL;
+    gsl_interp_accel *ia = NULL;
+
+    x_support = malloc(n_support*sizeof(double));
+    b_support = malloc(n_support*sizeof(double));
+    x_nodes = malloc(bpw->n_ell*sizeof(double));
+    y_nodes = calloc(bpw->n_ell, sizeof(double));
+    intp = gsl_interp_alloc(gsl_interp_cspline, bpw->n_ell);
+    ia = gsl_interp_accel_alloc();
+    if ((x_support == NULL) || (b_support == NULL) || (x_nodes == NULL) ||
+        (y_nodes == NULL) || (intp == NULL) || (ia == NULL))
+      *status = CCL_ERROR_MEMORY;
+
+    if (*status == 0) {
+      for (is=0; is < bpw->n_ell; is++) {
+        x_nodes[is] = x_min+(x_max-x_min)*is/(bpw->n_ell-1.);
+        bpw->ell[is] = exp(x_nodes[is])-1;
+      }
+      // Avoid rounding errors at the edges
+      x_nodes[0] = x_min;
+      x_nodes[bpw->n_ell-1] = x_max;
+      bpw->ell[0] = l_min;
+      bpw->ell[bpw->n_ell-1] = l_max;
+      for (il=0; il <= l_max-l_min; il++) {
+        if (support_index[il] >= 0)
+          x_support[support_index[il]] = log(l_min+il+1.);
+      }
+    }
+
+    for (is=0; is < bpw->n_ell; is++) {
+      if (*status)
+        break;
+      y_nodes[is] = 1;
+      if (gsl_interp_init(intp, x_nodes, y_nodes, bpw->n_ell)) {
+        *status = CCL_ERROR_SPLINE;
+        break;
+      }
+      gsl_interp_accel_reset(ia);
+      for (il=0; il < n_support; il++) {
+        if (gsl_interp_eval_e(intp, x_nodes, y_nodes, x_support[il], ia,
+                              &(b_support[il]))) {
+          *status = CCL_ERROR_SPLINE_EV;
+          break;
+        }
+      }
+      y_nodes[is] = 0;
+
+      for (ib=0; ib < n_bpw; ib++) {
+        double w = 0;
+        for (inz=bpw_start[ib]; inz < bpw_start[ib+1]; inz++)
+          w += w_nz[inz]*b_support[support_index[ell_nz[inz]-l_min]];
+        bpw->w[ib*bpw->n_ell+is] = w;
+      }
+    }
+
+    gsl_interp_free(intp);
+    gsl_interp_accel_free(ia);
+    free(x_nodes);
+    free(y_nodes);
+    free(b_support);
+  }
+
+  free(support_index);
+  free(x_support);
+  if (*status) {
+    ccl_bandpowers_t_free(bpw);
+    bpw = NULL;
+  }
+  return bpw;
+}
+
+void ccl_bandpowers_t_free(ccl_bandpowers_t *bpw) {
+  if (bpw != NULL) {
+    free(bpw->ell);
+    free(bpw->w);
+    free(bpw);
+  }
+}
+
+/* ------- ROUTINE: ccl_angular_cls_limber_bandpowers ------
+INPUTS: cosmology, tracers, power spectrum, bandpower windows, integration
+        method
+TASK: compute Limber bandpowers. Power spectra are only computed at the
+      multipoles needed by the windows, and then convolved with them.
+*/
+void ccl_angular_cls_limber_bandpowers(ccl_cosmology *cosmo,
+                                       ccl_cl_tracer_collection_t *trc1,
+                                       ccl_cl_tracer_collection_t *trc2,
+                                       ccl_f2d_t *psp,
+                                       ccl_bandpowers_t *bpw,
+                                       double *bpw_out,
+                                       ccl_integration_t integration_method,
+                                       int *status) {
+  double *cl = malloc(bpw->n_ell*sizeof(double));
+  if (cl == NULL) {
+    *status = CCL_ERROR_MEMORY;
+    return;
+  }
+
+  angular_cls_limber(cosmo, trc1, trc2, psp, bpw->n_ell, bpw->ell, cl,
+                     integration_method, 1, status);
+
+  if (*status == 0) {
+    gsl_matrix_view w = gsl_matrix_view_array(bpw->w, bpw->n_bpw,
+                                              bpw->n_ell);
+    gsl_vector_view cl_v = gsl_vector_view_array(cl, bpw->n_ell);
+    gsl_vector_view out_v = gsl_vector_view_array(bpw_out, bpw->n_bpw);
+    gsl_blas_dgemv(CblasNoTrans, 1., &(w.matrix), &(cl_v.vector),
+                   0., &(out_v.vector));
+  }
+  free(cl);
+}
+
+ccl_data_vector_t *ccl_data_vector_t_new(int *status) {
+  ccl_data_vector_t *dv = NULL;
+  dv = malloc(sizeof(ccl_data_vector_t));
+  if (dv == NULL)
+    *status = CCL_ERROR_MEMORY;
+
+  if (*status == 0) {
+    dv->n_pairs = 0;
+    dv->trc1 = malloc(CCL_MAX_DATA_VECTOR_PAIRS*sizeof(ccl_cl_tracer_collection_t *));
+    dv->trc2 = malloc(CCL_MAX_DATA_VECTOR_PAIRS*sizeof(ccl_cl_tracer_collection_t *));
+    dv->corr_type = malloc(CCL_MAX_DATA_VECTOR_PAIRS*sizeof(int));
+    dv->x_min = malloc(CCL_MAX_DATA_VECTOR_PAIRS*sizeof(double));
+    dv->x_max = malloc(CCL_MAX_DATA_VECTOR_PAIRS*sizeof(double));
+    if ((dv->trc1 == NULL) || (dv->trc2 == NULL) || (dv->corr_type == NULL) ||
+        (dv->x_min == NULL) || (dv->x_max == NULL)) {
+      *status = CCL_ERROR_MEMORY;
+      ccl_data_vector_t_free(dv);
+      dv = NULL;
+    }
+  }
+
+  return dv;
+}
+
+void ccl_data_vector_t_free(ccl_data_vector_t *dv) {
+  if (dv != NULL) {
+    free(dv->trc1);
+    free(dv->trc2);
+    free(dv->corr_type);
+    free(dv->x_min);
+    free(dv->x_max);
+    free(dv);
+  }
+}
+
+void ccl_add_data_vector_pair(ccl_data_vector_t *dv,
+                              ccl_cl_tracer_collection_t *trc1,
+                              ccl_cl_tracer_collection_t *trc2,
+                              int corr_type, double x_min, double x_max,
+                              int *status) {
+  if (dv->n_pairs >= CCL_MAX_DATA_VECTOR_PAIRS) {
+    *status = CCL_ERROR_MEMORY;
+    return;
+  }
+  if ((corr_type != 0) && (corr_type != CCL_CORR_GG) &&
+      (corr_type != CCL_CORR_GL) && (corr_type != CCL_CORR_LP) &&
+      (corr_type != CCL_CORR_LM)) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return;
+  }
+  dv->trc1[dv->n_pairs] = trc1;
+  dv->trc2[dv->n_pairs] = trc2;
+  dv->corr_type[dv->n_pairs] = corr_type;
+  dv->x_min[dv->n_pairs] = x_min;
+  dv->x_max[dv->n_pairs] = x_max;
+  dv->n_pairs++;
+}
+
+// Number of scales of pair ip that pass its scale cuts
+static int data_vector_pair_size(ccl_data_vector_t *dv, int ip,
+                                 int n_ell, double *ell,
+                                 int n_theta, double *theta) {
+  int i, n = 0;
+  int nx = dv->corr_type[ip] ? n_theta : n_ell;
+  double *x = dv->corr_type[ip] ? theta : ell;
+
+  for (i=0; i < nx; i++) {
+    if ((x[i] >= dv->x_min[ip]) && (x[i] <= dv->x_max[ip]))
+      n++;
+  }
+  return n;
+}
+
+int ccl_data_vector_t_size(ccl_data_vector_t *dv,
+                           int n_ell, double *ell,
+                           int n_theta, double *theta) {
+  int ip, n = 0;
+  for (ip=0; ip < dv->n_pairs; ip++)
+    n += data_vector_pair_size(dv, ip, n_ell, ell, n_theta, theta);
+  return n;
+}
+
+// Order of the Bessel function of the FFTLog transform of each correlation
+static int corr_type_bessel(int corr_type) {
+  if (corr_type == CCL_CORR_GL)
+    return 2;
+  if (corr_type == CCL_CORR_LM)
+    return 4;
+  return 0;
+}
+
+/* ------- ROUTINE: ccl_angular_data_vector_limber ------
+INPUTS: cosmology, power spectrum, pairs of tracers with their output type
+        and scale cuts, output multipoles, output angles (in degrees),
+        multipoles at which power spectra are sampled for correlation
+        functions, integration method
+TASK: compute a data vector made of Limber power spectra and correlation
+      functions. All Limber integrals are computed in one parallel region,
+      correlation functions sharing the same tracers share their power
+      spectrum, and all correlation functions with the same Bessel order
+      are computed with a single FFTLog call.
+*/
+void ccl_angular_data_vector_limber(ccl_cosmology *cosmo, ccl_f2d_t *psp,
+                                    ccl_data_vector_t *dv,
+                                    int n_ell, double *ell,
+                                    int n_theta, double *theta,
+                                    int n_ell_sample, double *ell_sample,
+                                    double *dv_out,
+                                    ccl_integration_t integration_method,
+                                    int *status) {
+  int ip, is, i, ib, n_spec = 0, n_tasks = 0;
+  int n_fft = cosmo->spline_params.N_ELL_CORR;
+  int *pair_spec = NULL, *pair_offset = NULL;
+  int *task_pair = NULL;
+  double *task_l = NULL, **task_out = NULL;
+  double *cl_sample = NULL, *l_fft = NULL, *th_fft = NULL;
+  double *cl_fft = NULL, *xi_fft = NULL;
+  double **cl_group = NULL, **xi_group = NULL;
+
+  if (!cosmo->computed_distances) {
+    *status = CCL_ERROR_DISTANCES_INIT;
+    ccl_cosmology_set_status_message(
+      cosmo,
+      "ccl_cls.c: ccl_angular_data_vector_limber(): distance splines have not been precomputed!");
+    return;
+  }
+
+  pair_spec = malloc(dv->n_pairs*sizeof(int));
+  pair_offset = malloc((dv->n_pairs+1)*sizeof(int));
+  if ((pair_spec == NULL) || (pair_offset == NULL))
+    *status = CCL_ERROR_MEMORY;
+
+  if (*status == 0) {
+    // Assign a power spectrum to each correlation function. Swapping
+    // the two tracers does not change it.
+    pair_offset[0] = 0;
+    for (ip=0; ip < dv->n_pairs; ip++) {
+      pair_offset[ip+1] = pair_offset[ip] +
+        data_vector_pair_size(dv, ip, n_ell, ell, n_theta, theta);
+      pair_spec[ip] = -1;
+      if (dv->corr_type[ip] == 0)
+        continue;
+      for (i=0; i < ip; i++) {
+        if ((dv->corr_type[i] != 0) &&
+            (((dv->trc1[i] == dv->trc1[ip]) && (dv->trc2[i] == dv->trc2[ip])) ||
+             ((dv->trc1[i] == dv->trc2[ip]) && (dv->trc2[i] == dv->trc1[ip])))) {
+          pair_spec[ip] = pair_spec[i];
+          break;
+        }
+      }
+      if (pair_spec[ip] < 0)
+        pair_spec[ip] = n_spec++;
+    }
+
+    if ((n_spec > 0) && (n_ell_sample < 2)) {
+      *status = CCL_ERROR_INCONSISTENT;
+      ccl_cosmology_set_status_message(
+        cosmo,
+        "ccl_cls.c: ccl_angular_data_vector_limber(): correlation functions "
+        "need at least two multipoles to sample power spectra\n");
+    }
+  }
+
+  if (*status == 0) {
+    // One task per Limber integral: power spectra at the multipoles that
+    // pass the scale cuts, and sampled power spectra of correlations.
+    n_tasks = n_spec*n_ell_sample;
+    for (ip=0; ip < dv->n_pairs; ip++) {
+      if (dv->corr_type[ip] == 0)
+        n_tasks += pair_offset[ip+1]-pair_offset[ip];
+    }
+    task_pair = malloc(n_tasks*sizeof(int));
+    task_l = malloc(n_tasks*sizeof(double));
+    task_out = malloc(n_tasks*sizeof(double *));
+    cl_sample = malloc(n_spec*n_ell_sample*sizeof(double));
+    if (((n_tasks > 0) &&
+         ((task_pair == NULL) || (task_l == NULL) || (task_out == NULL))) ||
+        ((n_spec > 0) && (cl_sample == NULL)))
+      *status = CCL_ERROR_MEMORY;
+  }
+
+  if (*status == 0) {
+    int it = 0;
+    for (ip=0; ip < dv->n_pairs; ip++) {
+      if (dv->corr_type[ip] == 0) {
+        int iout = pair_offset[ip];
+        for (i=0; i < n_ell; i++) {
+          if ((ell[i] >= dv->x_min[ip]) && (ell[i] <= dv->x_max[ip])) {
+            task_pair[it] = ip;
+            task_l[it] = ell[i];
+            task_out[it] = &(dv_out[iout++]);
+            it++;
+          }
+        }
+      }
+      else {
+        // Only the first pair using each power spectrum computes it
+        int first = 1;
+        for (i=0; i < ip; i++) {
+          if (pair_spec[i] == pair_spec[ip])
+            first = 0;
+        }
+        for (i=0; first && (i < n_ell_sample); i++) {
+          task_pair[it] = ip;
+          task_l[it] = ell_sample[i];
+          task_out[it] = &(cl_sample[pair_spec[ip]*n_ell_sample+i]);
+          it++;
+        }
+      }
+    }
+  }
+
+  if (*status == 0) {
+    #pragma omp parallel shared(cosmo, psp, dv, n_tasks, task_pair, task_l, \
+                                task_out, status, integration_method) \
+                         default(none)
+    {
+      int it;
+      integ_cl_par ipar;
+      gsl_integration_workspace *w = NULL;
+      int local_status = *status;
+
+      ipar.order = 1;
+      ipar.cosmo = cosmo;
+      ipar.psp = psp;
+
+      if((integration_method == ccl_integration_qag_quad) &&
+         (local_status == 0)) {
+        w = ccl_workspace_get_integration(cosmo->gsl_params.N_ITERATION);
+        if (w == NULL)
+          local_status = CCL_ERROR_MEMORY;
+      }
+
+      #pragma omp for schedule(dynamic)
+      for (it=0; it < n_tasks; ++it) {
+        if (local_status == 0) {
+          ipar.trc1 = dv->trc1[task_pair[it]];
+          ipar.trc2 = dv->trc2[task_pair[it]];
+          *(task_out[it]) = integ_cls_limber_ell(&ipar, task_l[it],
+                                                 integration_method, w,
+                                                 &local_status);
+        }
+      }
+
+      ccl_workspace_put_integration(w);
+      ccl_workspace_release();
+
+      if (local_status) {
+        #pragma omp atomic write
+        *status = local_status;
+      }
+    } //end omp parallel
+
+    if (*status) {
+      ccl_cosmology_set_status_message(
+        cosmo,
+        "ccl_cls.c: ccl_angular_data_vector_limber(); integration error\n");
+    }
+  }
+
+  if ((*status == 0) && (n_spec > 0)) {
+    // Resample the power spectra on the FFTLog grid
+    l_fft = ccl_log_spacing(cosmo->spline_params.ELL_MIN_CORR,
+                            cosmo->spline_params.ELL_MAX_CORR, n_fft);
+    th_fft = malloc(n_fft*sizeof(double));
+    cl_fft = malloc(n_spec*n_fft*sizeof(double));
+    xi_fft = malloc(n_spec*n_fft*sizeof(double));
+    cl_group = malloc(n_spec*sizeof(double *));
+    xi_group = malloc(n_spec*sizeof(double *));
+    if ((l_fft == NULL) || (th_fft == NULL) || (cl_fft == NULL) ||
+        (xi_fft == NULL) || (cl_group == NULL) || (xi_group == NULL)) {
+      *status = CCL_ERROR_MEMORY;
+      ccl_cosmology_set_status_message(
+        cosmo,
+        "ccl_cls.c: ccl_angular_data_vector_limber(): ran out of memory\n");
+    }
+
+    for (is=0; is < n_spec; is++) {
+      double *cls = cl_sample+is*n_ell_sample;
+      ccl_f1d_t *cl_spl;
+
+      if (*status)
+        break;
+      cl_spl = ccl_f1d_t_new(n_ell_sample, ell_sample, cls, cls[0], 0,
+                             ccl_f1d_extrap_const,
+                             ccl_f1d_extrap_logx_logy, status);
+      if (cl_spl == NULL) {
+        if (*status == 0)
+          *status = CCL_ERROR_MEMORY;
+        ccl_cosmology_set_status_message(
+          cosmo,
+          "ccl_cls.c: ccl_angular_data_vector_limber(): "
+          "failed to create spline\n");
+        break;
+      }
+      for (i=0; i < n_fft; i++)
+        cl_fft[is*n_fft+i] = ccl_f1d_t_eval(cl_spl, l_fft[i]);
+      ccl_f1d_t_free(cl_spl);
+    }
+  }
+
+  // One FFTLog transform per Bessel order, for all power spectra that need it
+  for (ib=0; ib <= 4; ib += 2) {
+    int n_group = 0;
+
+    if ((*status) || (n_spec == 0))
+      break;
+
+    for (is=0; is < n_spec; is++) {
+      for (ip=0; ip < dv->n_pairs; ip++) {
+        if ((pair_spec[ip] == is) &&
+            (corr_type_bessel(dv->corr_type[ip]) == ib)) {
+          cl_group[n_group] = cl_fft+is*n_fft;
+          xi_group[n_group] = xi_fft+is*n_fft;
+          n_group++;
+          break;
+        }
       }
     }
+    if (n_group == 0)
+      continue;
+
+    for (i=0; i < n_fft; i++)
+      th_fft[i] = 0;
+    ccl_fftlog_ComputeXi2D(ib, 0, n_group, n_fft, l_fft, cl_group,
+                           th_fft, xi_group, status);
+    if (*status) {
+      ccl_cosmology_set_status_message(
+        cosmo,
+        "ccl_cls.c: ccl_angular_data_vector_limber(): FFTLog failed\n");
+      break;
+    }
+
+    // Interpolate to the output angles
+    for (ip=0; ip < dv->n_pairs; ip++) {
+      double *xi;
+      int iout = pair_offset[ip];
+      ccl_f1d_t *xi_spl;
+
+      if ((pair_spec[ip] < 0) ||
+          (corr_type_bessel(dv->corr_type[ip]) != ib))
+        continue;
+
+      xi = xi_fft+pair_spec[ip]*n_fft;
+      xi_spl = ccl_f1d_t_new(n_fft, th_fft, xi, xi[0], 0,
+                             ccl_f1d_extrap_const,
+                             ccl_f1d_extrap_const, status);
+      if (xi_spl == NULL) {
+        if (*status == 0)
+          *status = CCL_ERROR_MEMORY;
+        ccl_cosmology_set_status_message(
+          cosmo,
+          "ccl_cls.c: ccl_angular_data_vector_limber(): "
+          "failed to create spline\n");
+        break;
+      }
+      for (i=0; i < n_theta; i++) {
+        if ((theta[i] >= dv->x_min[ip]) && (theta[i] <= dv->x_max[ip]))
+          dv_out[iout++] = ccl_f1d_t_eval(xi_spl, theta[i]*M_PI/180.);
+      }
+      ccl_f1d_t_free(xi_spl);
+    }
+  }
+
+  free(pair_spec);
+  free(pair_offset);
+  free(task_pair);
+  free(task_l);
+  free(task_out);
+  free(cl_sample);
+  free(l_fft);
+  free(th_fft);
+  free(cl_fft);
+  free(xi_fft);
+  free(cl_group);
+  free(xi_group);
+}
+
+ccl_cl_derivs_t *ccl_cl_derivs_t_new(int *status) {
+  ccl_cl_derivs_t *derivs = NULL;
+  derivs = malloc(sizeof(ccl_cl_derivs_t));
+  if (derivs == NULL)
+    *status = CCL_ERROR_MEMORY;
+
+  if (*status == 0) {
+    derivs->n_par = 0;
+    derivs->dtrc1 = malloc(CCL_MAX_CL_DERIVS*sizeof(ccl_cl_tracer_collection_t *));
+    derivs->dtrc2 = malloc(CCL_MAX_CL_DERIVS*sizeof(ccl_cl_tracer_collection_t *));
+    derivs->dpsp = malloc(CCL_MAX_CL_DERIVS*sizeof(ccl_f2d_t *));
+    if ((derivs->dtrc1 == NULL) || (derivs->dtrc2 == NULL) ||
+        (derivs->dpsp == NULL)) {
+      *status = CCL_ERROR_MEMORY;
+      ccl_cl_derivs_t_free(derivs);
+      derivs = NULL;
+    }
+  }
+
+  return derivs;
+}
+
+void ccl_cl_derivs_t_free(ccl_cl_derivs_t *derivs) {
+  if (derivs != NULL) {
+    free(derivs->dtrc1);
+    free(derivs->dtrc2);
+    free(derivs->dpsp);
+    free(derivs);
+  }
+}
+
+void ccl_add_cl_deriv(ccl_cl_derivs_t *derivs,
+                      ccl_cl_tracer_collection_t *dtrc1,
+                      ccl_cl_tracer_collection_t *dtrc2,
+                      ccl_f2d_t *dpsp, int *status) {
+  if (derivs->n_par >= CCL_MAX_CL_DERIVS) {
+    *status = CCL_ERROR_MEMORY;
+    return;
+  }
+  derivs->dtrc1[derivs->n_par] = dtrc1;
+  derivs->dtrc2[derivs->n_par] = dtrc2;
+  derivs->dpsp[derivs->n_par] = dpsp;
+  derivs->n_par++;
+}
+
+// Widens [lkmin, lkmax] to cover the support of a pair of collections
+static void update_k_interval(ccl_cosmology *cosmo,
+                              ccl_cl_tracer_collection_t *trc1,
+                              ccl_cl_tracer_collection_t *trc2,
+                              double l, double *lkmin, double *lkmax) {
+  double lkmin_h, lkmax_h;
+
+  if ((trc1 == NULL) || (trc2 == NULL) ||
+      (trc1->n_tracers == 0) || (trc2->n_tracers == 0))
+    return;
+
+  get_k_interval(cosmo, trc1, trc2, l, &lkmin_h, &lkmax_h);
+  if (lkmin_h < *lkmin)
+    *lkmin = lkmin_h;
+  if (lkmax_h > *lkmax)
+    *lkmax = lkmax_h;
+}
+
+/* ------- ROUTINE: integ_cls_limber_derivs ------
+INPUTS: cosmology, base tracers and power spectrum, their derivatives,
+        multipole, k range, output array with one element per parameter
+TASK: integrate the derivative of the Limber integrand with respect to
+      all parameters on the same set of log(k) nodes.
+*/
+static void integ_cls_limber_derivs(ccl_cosmology *cosmo,
+                                    ccl_cl_tracer_collection_t *trc1,
+                                    ccl_cl_tracer_collection_t *trc2,
+                                    ccl_f2d_t *psp,
+                                    ccl_cl_derivs_t *derivs,
+                                    double l, double lkmin, double lkmax,
+                                    double **fk_arr, double *result,
+                                    int *status) {
+  int ik, ip;
+  int n_par = derivs->n_par;
+  int nk = (int)(fmax((lkmax - lkmin) / cosmo->spline_params.DLOGK_INTEGRATION + 0.5,
+                      1))+1;
+  double dlk = (lkmax - lkmin) / (nk - 1.);
+  double *lk_arr = ccl_workspace_get_doubles(nk);
+  double *fk_all = ccl_workspace_get_doubles(n_par*nk);
+  if ((lk_arr == NULL) || (fk_all == NULL))
+    *status = CCL_ERROR_MEMORY;
+
+  if (*status == 0) {
+    for (ip=0; ip < n_par; ip++)
+      fk_arr[ip] = fk_all + ip*nk;
+
+    for (ik=0; ik < nk; ik++)
+      lk_arr[ik] = lkmin + dlk*ik;
+    lk_arr[nk-1] = lkmax;
+
+    for (ik=0; ik < nk; ik++) {
+      double lk = lk_arr[ik];
+      double k = exp(lk);
+      double chi = (l+0.5)/k;
+      double a = ccl_scale_factor_of_chi(cosmo, chi, status);
+
+      // Base quantities, shared by all parameters
+      double d1 = transfer_limber_wrap(l, lk, k, chi, a, trc1,
+                                       cosmo, psp, 0, status);
+      double d2 = transfer_limber_wrap(l, lk, k, chi, a, trc2,
+                                       cosmo, psp, 0, status);
+      double pk = ccl_f2d_t_eval(psp, lk, a, cosmo, status);
+
+      for (ip=0; ip < n_par; ip++) {
+        double f = 0;
+        if (derivs->dtrc1[ip] != NULL)
+          f += transfer_limber_wrap(l, lk, k, chi, a, derivs->dtrc1[ip],
+                                    cosmo, psp, 0, status)*d2*pk;
+        if (derivs->dtrc2[ip] != NULL)
+          f += d1*transfer_limber_wrap(l, lk, k, chi, a, derivs->dtrc2[ip],
+                                       cosmo, psp, 0, status)*pk;
+        if ((derivs->dpsp[ip] != NULL) && (d1 != 0) && (d2 != 0))
+          f += d1*d2*ccl_f2d_t_eval(derivs->dpsp[ip], lk, a, cosmo, status);
+        fk_arr[ip][ik] = k*f;
+      }
+      if (*status)
+        break;
+    }
+  }
+
+  if (*status == 0) {
+    ccl_integ_spline(n_par, nk, lk_arr, fk_arr,
+                     1, -1, result, gsl_interp_akima,
+                     status);
+  }
+  ccl_workspace_put_doubles(fk_all);
+  ccl_workspace_put_doubles(lk_arr);
+}
+
+void ccl_angular_cls_limber_derivs(ccl_cosmology *cosmo,
+                                   ccl_cl_tracer_collection_t *trc1,
+                                   ccl_cl_tracer_collection_t *trc2,
+                                   ccl_f2d_t *psp,
+                                   ccl_cl_derivs_t *derivs,
+                                   int nl_out, double *l_out,
+                                   double *dcl_out, int *status) {
+
+  // make sure to init core things for safety
+  if (!cosmo->computed_distances) {
+    *status = CCL_ERROR_DISTANCES_INIT;
+    ccl_cosmology_set_status_message(
+      cosmo,
+      "ccl_cls.c: ccl_angular_cls_limber_derivs(): distance splines have not been precomputed!");
+    return;
+  }
+
+  if (derivs->n_par == 0)
+    return;
+
+  #pragma omp parallel shared(cosmo, trc1, trc2, l_out, dcl_out, \
+                              nl_out, status, psp, derivs) \
+                       default(none)
+  {
+    int lind, ip;
+    int n_par = derivs->n_par;
+    int local_status = *status;
+    double lkmin, lkmax, l;
+    double **fk_arr = NULL;
+    double *result = NULL;
+
+    if (local_status == 0) {
+      fk_arr = malloc(n_par*sizeof(double *));
+      result = malloc(n_par*sizeof(double));
+      if ((fk_arr == NULL) || (result == NULL))
+        local_status = CCL_ERROR_MEMORY;
+    }
 
     #pragma omp for schedule(dynamic)
     for (lind=0; lind < nl_out; ++lind) {
       if (local_status == 0) {
         l = l_out[lind];
-        clastatus = 0;
-        ipar.l = l;
 
-        // Get integration limits
+        // Integration limits must cover the support of all derivatives
         get_k_interval(cosmo, trc1, trc2, l, &lkmin, &lkmax);
+        for (ip=0; ip < n_par; ip++) {
+          update_k_interval(cosmo, derivs->dtrc1[ip], trc2, l,
+                            &lkmin, &lkmax);
+          update_k_interval(cosmo, trc1, derivs->dtrc2[ip], l,
+                            &lkmin, &lkmax);
+        }
 
-	// Integrate
-	if(integration_method == ccl_integration_qag_quad) {
-	  integ_cls_limber_qag_quad(cosmo, &F, lkmin, lkmax, w,
-				    &result, &eresult, &local_status);
-	}
-	else if(integration_method == ccl_integration_spline) {
-	  integ_cls_limber_spline(cosmo, &ipar, lkmin, lkmax,
-				  &result, &local_status);
-	}
-	else
-	  local_status = CCL_ERROR_NOT_IMPLEMENTED;
+        integ_cls_limber_derivs(cosmo, trc1, trc2, psp, derivs,
+                                l, lkmin, lkmax, fk_arr, result,
+                                &local_status);
 
-        if ((*ipar.status == 0) && (local_status == 0)) {
-          cl_out[lind] = result / (l+0.5);
+        for (ip=0; ip < n_par; ip++) {
+          if (local_status == 0)
+            dcl_out[ip*nl_out+lind] = result[ip] / (l+0.5);
+          else
+            dcl_out[ip*nl_out+lind] = NAN;
         }
-        else {
-          ccl_raise_gsl_warning(local_status, "ccl_cls.c: ccl_angular_cls_limber():");
-          cl_out[lind] = NAN;
+        if (local_status) {
+          ccl_raise_gsl_warning(local_status, "ccl_cls.c: ccl_angular_cls_limber_derivs():");
           local_status = CCL_ERROR_INTEG;
         }
       }
     }
 
-    gsl_integration_workspace_free(w);
+    free(fk_arr);
+    free(result);
+    ccl_workspace_release();
 
     if (local_status) {
       #pragma omp atomic write
@@ -358,7 +1388,7 @@ void ccl_angular_cls_limber(ccl_cosmology *cosmo,
   if (*status) {
     ccl_cosmology_set_status_message(
       cosmo,
-      "ccl_cls.c: ccl_angular_cls_limber(); integration error\n");
+      "ccl_cls.c: ccl_angular_cls_limber_derivs(); integration error\n");
   }
 }
 
@@ -417,19 +1447,19 @@ static void integ_cov_limber_spline(ccl_cosmology *cosmo,
   int ichi;
   int nchi = (int)(fmax((chimax - chimin) / cosmo->spline_params.DCHI_INTEGRATION + 0.5,
 		      1))+1;
-  double *fchi_arr = NULL;
-  double *chi_arr = NULL;
-  chi_arr = ccl_linear_spacing(chimin, chimax, nchi);
-  if(chi_arr == NULL)
-    *status = CCL_ERROR_LOGSPACE;
+  double dchi = (chimax - chimin) / (nchi - 1.);
+  // Scratch arrays come from the thread's pool, as this runs once per
+  // pair of ells
+  double *chi_arr = ccl_workspace_get_doubles(nchi);
+  double *fchi_arr = ccl_workspace_get_doubles(nchi);
+  if((chi_arr == NULL) || (fchi_arr == NULL))
+    *status = CCL_ERROR_MEMORY;
 
   if(*status == 0) {
-    fchi_arr = malloc(nchi * sizeof(double));
-    if(fchi_arr == NULL)
-      *status = CCL_ERROR_MEMORY;
-  }
+    for(ichi=0; ichi<nchi; ichi++)
+      chi_arr[ichi] = chimin + dchi*ichi;
+    chi_arr[nchi-1] = chimax;
 
-  if(*status == 0) {
     for(ichi=0; ichi<nchi; ichi++) {
       fchi_arr[ichi] = cov_integrand(chi_arr[ichi], ipar);
       if(*(ipar->status)) {
@@ -445,8 +1475,8 @@ static void integ_cov_limber_spline(ccl_cosmology *cosmo,
                      status);
   }
 
-  free(fchi_arr);
-  free(chi_arr);
+  ccl_workspace_put_doubles(fchi_arr);
+  ccl_workspace_put_doubles(chi_arr);
 }
 
 static void integ_cov_limber_qag_quad(ccl_cosmology *cosmo,
@@ -471,7 +1501,7 @@ static void integ_cov_limber_qag_quad(ccl_cosmology *cosmo,
     ccl_raise_gsl_warning(gslstatus,
 			  "ccl_cls.c: ccl_angular_cov_limber(): "
 			  "Default GSL integration failure, attempting backup method.");
-    w_cquad = gsl_integration_cquad_workspace_alloc(cosmo->gsl_params.N_ITERATION);
+    w_cquad = ccl_workspace_get_cquad(cosmo->gsl_params.N_ITERATION);
     if (w_cquad == NULL)
       *status = CCL_ERROR_MEMORY;
 
@@ -482,7 +1512,7 @@ static void integ_cov_limber_qag_quad(ccl_cosmology *cosmo,
 					w_cquad, result, eresult, &nevals);
     }
   }
-  gsl_integration_cquad_workspace_free(w_cquad);
+  ccl_workspace_put_cquad(w_cquad);
   if(*status == 0)
     *status = gslstatus;
 }
@@ -547,7 +1577,7 @@ void ccl_angular_cl_covariance(ccl_cosmology *cosmo,
 
     if(integration_method == ccl_integration_qag_quad) {
       if (local_status == 0) {
-	w = gsl_integration_workspace_alloc(cosmo->gsl_params.N_ITERATION);
+	w = ccl_workspace_get_integration(cosmo->gsl_params.N_ITERATION);
 	if (w == NULL) {
 	  local_status = CCL_ERROR_MEMORY;
 	}
@@ -595,7 +1625,8 @@ void ccl_angular_cl_covariance(ccl_cosmology *cosmo,
       }
     }
 
-    gsl_integration_workspace_free(w);
+    ccl_workspace_put_integration(w);
+    ccl_workspace_release();
     
     if (local_status) {
       #pragma omp atomic write
@@ -610,3 +1641,76 @@ void ccl_angular_cl_covariance(ccl_cosmology *cosmo,
       "ccl_cls.c: ccl_angular_cov_limber(); integration error\n");
   }
 }
+
+/* ------- ROUTINE: ccl_angular_cl_covariance_gaussian ------
+INPUTS: number of tracers, multipoles and bin widths, tensor of power spectra
+        C^{ij}_l (and optionally noise N^{ij}_l) with layout
+        [(i*n_tr+j)*n_ell+il], sky fraction, list of tracer pairs
+TASK: compute the Gaussian (Knox) covariance between all pairs of power
+      spectra. Since it is diagonal in ell, only the diagonal of each
+      (pair, pair) block is stored, with layout [(p*n_pairs+q)*n_ell+il].
+*/
+void ccl_angular_cl_covariance_gaussian(int n_tr, int n_ell,
+                                        double *ell, double *delta_ell,
+                                        double *cl, double *noise,
+                                        double fsky,
+                                        int n_pairs, int *pair_i, int *pair_j,
+                                        double *cov_out, int *status)
+{
+  int ip;
+
+  if((n_tr <= 0) || (n_ell <= 0) || (n_pairs <= 0) ||
+     (fsky <= 0) || (fsky > 1)) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return;
+  }
+  for(ip=0; ip < n_pairs; ip++) {
+    if((pair_i[ip] < 0) || (pair_i[ip] >= n_tr) ||
+       (pair_j[ip] < 0) || (pair_j[ip] >= n_tr)) {
+      *status = CCL_ERROR_INCONSISTENT;
+      return;
+    }
+  }
+  for(ip=0; ip < n_ell; ip++) {
+    if((delta_ell != NULL) && (delta_ell[ip] <= 0)) {
+      *status = CCL_ERROR_INCONSISTENT;
+      return;
+    }
+  }
+
+  #pragma omp parallel shared(n_tr, n_ell, ell, delta_ell, cl, noise, fsky, \
+                              n_pairs, pair_i, pair_j, cov_out) \
+                       default(none)
+  {
+    int p, q, il;
+
+    // Each thread fills whole rows of (p, q) blocks. The blocks are
+    // symmetric, so only q >= p is computed and mirrored.
+    #pragma omp for schedule(dynamic)
+    for(p=0; p < n_pairs; p++) {
+      int a = pair_i[p], b = pair_j[p];
+      for(q=p; q < n_pairs; q++) {
+        int c = pair_i[q], d = pair_j[q];
+        double *ac = cl+(a*n_tr+c)*n_ell, *bd = cl+(b*n_tr+d)*n_ell;
+        double *ad = cl+(a*n_tr+d)*n_ell, *bc = cl+(b*n_tr+c)*n_ell;
+        double *cov_pq = cov_out+(p*n_pairs+q)*n_ell;
+        double *cov_qp = cov_out+(q*n_pairs+p)*n_ell;
+
+        for(il=0; il < n_ell; il++) {
+          double s_ac = ac[il], s_bd = bd[il], s_ad = ad[il], s_bc = bc[il];
+          double nmodes = (2*ell[il]+1)*fsky;
+          if(delta_ell != NULL)
+            nmodes *= delta_ell[il];
+          if(noise != NULL) {
+            s_ac += noise[(a*n_tr+c)*n_ell+il];
+            s_bd += noise[(b*n_tr+d)*n_ell+il];
+            s_ad += noise[(a*n_tr+d)*n_ell+il];
+            s_bc += noise[(b*n_tr+c)*n_ell+il];
+          }
+          cov_pq[il] = (s_ac*s_bd+s_ad*s_bc)/nmodes;
+          cov_qp[il] = cov_pq[il];
+        }
+      }
+    }
+  } //end omp parallel
+}
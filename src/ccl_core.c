@@ -260,6 +260,8 @@ ccl_cosmology * ccl_cosmology_create(ccl_parameters params, ccl_configuration co
   cosmo->data.E = NULL;
   cosmo->data.growth0 = 1.;
   cosmo->data.achi = NULL;
+  cosmo->data.Om = NULL;
+  cosmo->data.Delta_vir = NULL;
 
   cosmo->data.logsigma = NULL;
 
@@ -270,6 +272,7 @@ ccl_cosmology * ccl_cosmology_create(ccl_parameters params, ccl_configuration co
   cosmo->computed_distances = false;
   cosmo->computed_growth = false;
   cosmo->computed_sigma = false;
+  cosmo->computed_halo_background = false;
   cosmo->status = 0;
   // Initialise as 0-length string
   cosmo->status_message[0] = '\0';
@@ -489,6 +492,8 @@ void ccl_data_free(ccl_data * data) {
   gsl_spline_free(data->fgrowth);
   gsl_spline_free(data->E);
   gsl_spline_free(data->achi);
+  gsl_spline_free(data->Om);
+  gsl_spline_free(data->Delta_vir);
   gsl_spline2d_free(data->logsigma);
   ccl_f1d_t_free(data->rsd_splines[0]);
   ccl_f1d_t_free(data->rsd_splines[1]);
@@ -972,3 +972,181 @@ void ccl_correlation_pi_sigma(ccl_cosmology *cosmo, ccl_f2d_t *psp,
 
   return;
 }
+
+// Number of points (odd, for Simpson's rule) used to integrate xi(s,mu)
+// in log(pi) beyond pi_max.
+#define CCL_CORR_PROJ_NPI 1025
+
+/*--------ROUTINE: corr_projected_tail ------
+TASK: Compute 2 * int_{pi_max}^{pi_end} dpi xi(sqrt(rp^2+pi^2), mu), where
+      xi(s,mu) = c0 xi_0(s) + c2 xi_2(s) P_2(mu) + c4 xi_4(s) P_4(mu).
+      The integral is done with Simpson's rule in log(pi), up to the largest
+      separation s_max at which the multipoles are known.
+INPUT: rp, pi_max, s_max, multipole splines (xi2 and xi4 may be NULL)
+       and their coefficients.
+*/
+static double corr_projected_tail(double rp, double pi_max, double s_max,
+                                  ccl_f1d_t *xi0, ccl_f1d_t *xi2, ccl_f1d_t *xi4,
+                                  double c0, double c2, double c4)
+{
+  int i;
+  double lpi_min, lpi_max, dlpi, sum = 0;
+
+  if (rp >= s_max)
+    return 0;
+  lpi_min = log(pi_max);
+  lpi_max = 0.5*log(s_max*s_max - rp*rp);
+  if (lpi_max <= lpi_min)
+    return 0;
+  dlpi = (lpi_max - lpi_min) / (CCL_CORR_PROJ_NPI - 1);
+
+  for (i = 0; i < CCL_CORR_PROJ_NPI; i++) {
+    double pi = exp(lpi_min + i*dlpi);
+    double s = sqrt(rp*rp + pi*pi);
+    double f = c0 * ccl_f1d_t_eval(xi0, s);
+    double w = (i == 0 || i == CCL_CORR_PROJ_NPI-1) ? 1 : ((i % 2) ? 4 : 2);
+    if (xi2 != NULL) {
+      double mu = pi / s;
+      f += c2 * ccl_f1d_t_eval(xi2, s) * gsl_sf_legendre_Pl(2, mu) +
+        c4 * ccl_f1d_t_eval(xi4, s) * gsl_sf_legendre_Pl(4, mu);
+    }
+    sum += w * f * pi;
+  }
+
+  return 2 * sum * dlpi / 3;
+}
+
+/*--------ROUTINE: ccl_correlation_projected ------
+TASK: Calculate the projected correlation function
+      wp(rp) = 2 * int_0^{pi_max} dpi xi(sqrt(rp^2+pi^2), mu)
+      at several scale factors. For pi_max -> infinity this is the
+      J_0 Hankel transform of P(k), computed with a single FFTLog call
+      for all scale factors. A finite pi_max is accounted for by
+      subtracting the line-of-sight integral of xi(s,mu) beyond pi_max,
+      optionally including the linear RSD multipoles.
+
+INPUT:  cosmology, number of scale factors, scale factors,
+        beta (= growth rate / bias) at each scale factor (or NULL for no RSD),
+        pi_max (<= 0 for infinity), number of rp values, rp values
+
+Projected correlation function will be in array wp, with wp[ia*n_rp+ir]
+ */
+void ccl_correlation_projected(ccl_cosmology *cosmo, ccl_f2d_t *psp,
+                               int n_a, double *a, double *beta,
+                               double pi_max, int n_rp, double *rp,
+                               double *wp, int *status) {
+  int i, ia, N_ARR, n_ell;
+  int do_tail = pi_max > 0;
+  int do_rsd = do_tail && (beta != NULL);
+  double *k_arr = NULL, *rp_arr = NULL, *s_arr = NULL, *buf = NULL;
+  double **pk_arr = NULL, **wp_arr = NULL, **xi_arr[3] = {NULL, NULL, NULL};
+
+  if ((n_a <= 0) || (n_rp <= 0))
+    return;
+
+  N_ARR = (int)(cosmo->spline_params.N_K_3DCOR * log10(cosmo->spline_params.K_MAX / cosmo->spline_params.K_MIN));
+  // Multipoles of the correlation function needed for the pi_max correction
+  n_ell = do_tail ? (do_rsd ? 3 : 1) : 0;
+
+  k_arr = ccl_log_spacing(cosmo->spline_params.K_MIN, cosmo->spline_params.K_MAX, N_ARR);
+  rp_arr = malloc(N_ARR * sizeof(double));
+  s_arr = malloc(N_ARR * sizeof(double));
+  buf = malloc((size_t)N_ARR * n_a * (2 + n_ell) * sizeof(double));
+  pk_arr = malloc(n_a * sizeof(double *));
+  wp_arr = malloc(n_a * sizeof(double *));
+  for (i = 0; i < n_ell; i++)
+    xi_arr[i] = malloc(n_a * sizeof(double *));
+  if ((k_arr == NULL) || (rp_arr == NULL) || (s_arr == NULL) || (buf == NULL) ||
+      (pk_arr == NULL) || (wp_arr == NULL) ||
+      ((n_ell > 0) && (xi_arr[0] == NULL)) ||
+      ((n_ell > 1) && ((xi_arr[1] == NULL) || (xi_arr[2] == NULL)))) {
+    *status = CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo,
+           "ccl_correlation.c: ccl_correlation_projected(): ran out of memory\n");
+  }
+
+  if (*status == 0) {
+    for (ia = 0; ia < n_a; ia++) {
+      pk_arr[ia] = buf + (size_t)N_ARR * ia;
+      wp_arr[ia] = buf + (size_t)N_ARR * (n_a + ia);
+      for (i = 0; i < n_ell; i++)
+        xi_arr[i][ia] = buf + (size_t)N_ARR * ((2 + i) * n_a + ia);
+      for (i = 0; i < N_ARR; i++)
+        pk_arr[ia][i] = ccl_f2d_t_eval(psp, log(k_arr[i]), a[ia], cosmo, status);
+    }
+  }
+
+  // wp(rp) for pi_max -> infinity: int dk k/(2pi) P(k) J_0(k rp)
+  if (*status == 0) {
+    for (i = 0; i < N_ARR; i++)
+      rp_arr[i] = 0;
+    ccl_fftlog_ComputeXi2D(0, 0, n_a, N_ARR, k_arr, pk_arr,
+                           rp_arr, wp_arr, status);
+  }
+
+  // Multipoles of xi(s) for the pi_max correction
+  for (i = 0; i < n_ell; i++) {
+    if (*status == 0) {
+      int j;
+      for (j = 0; j < N_ARR; j++)
+        s_arr[j] = 0;
+      ccl_fftlog_ComputeXi3D(2*i, 0, n_a, N_ARR, k_arr, pk_arr,
+                             s_arr, xi_arr[i], status);
+    }
+  }
+
+  for (ia = 0; ia < n_a; ia++) {
+    ccl_f1d_t *wp_spl = NULL, *xi_spl[3] = {NULL, NULL, NULL};
+    double b = do_rsd ? beta[ia] : 0;
+    double c0 = 1. + 2. / 3 * b + 1. / 5 * b * b;
+    double c2 = -(4. / 3 * b + 4. / 7 * b * b);
+    double c4 = 8. / 35 * b * b;
+
+    if (*status)
+      break;
+
+    wp_spl = ccl_f1d_t_new(N_ARR, rp_arr, wp_arr[ia], wp_arr[ia][0], 0,
+                           ccl_f1d_extrap_const,
+                           ccl_f1d_extrap_const, status);
+    for (i = 0; i < n_ell; i++)
+      xi_spl[i] = ccl_f1d_t_new(N_ARR, s_arr, xi_arr[i][ia], xi_arr[i][ia][0], 0,
+                                ccl_f1d_extrap_const,
+                                ccl_f1d_extrap_const, status);
+    if ((wp_spl == NULL) || ((n_ell > 0) && (xi_spl[0] == NULL)) ||
+        ((n_ell > 1) && ((xi_spl[1] == NULL) || (xi_spl[2] == NULL)))) {
+      *status = CCL_ERROR_MEMORY;
+      ccl_cosmology_set_status_message(cosmo,
+             "ccl_correlation.c: ccl_correlation_projected(): ran out of memory\n");
+    }
+
+    if (*status == 0) {
+      double s_max = s_arr[N_ARR-1];
+      #pragma omp parallel for default(none) \
+                           shared(n_rp, rp, wp, ia, wp_spl, xi_spl, do_tail, \
+                                  pi_max, s_max, c0, c2, c4)
+      for (i = 0; i < n_rp; i++) {
+        double w = ccl_f1d_t_eval(wp_spl, rp[i]);
+        if (do_tail)
+          w -= corr_projected_tail(rp[i], pi_max, s_max,
+                                   xi_spl[0], xi_spl[1], xi_spl[2],
+                                   c0, c2, c4);
+        wp[ia*n_rp+i] = w;
+      } //end omp parallel for
+    }
+
+    ccl_f1d_t_free(wp_spl);
+    for (i = 0; i < n_ell; i++)
+      ccl_f1d_t_free(xi_spl[i]);
+  }
+
+  free(k_arr);
+  free(rp_arr);
+  free(s_arr);
+  free(buf);
+  free(pk_arr);
+  free(wp_arr);
+  for (i = 0; i < n_ell; i++)
+    free(xi_arr[i]);
+
+  return;
+}
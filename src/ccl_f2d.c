@@ -531,6 +531,48 @@ double ccl_f2d_t_dlogf_dlk_eval(ccl_f2d_t *f2d,double lk,double a,void *cosmo, i
   return fka_post;
 }
 
+/* ------- ROUTINE: ccl_f2d_t_new_from_pk ------
+INPUTS: scale factors, log-wavenumbers, power spectrum values (not their
+        logarithm) with the wavenumber index running fastest,
+        extrapolation orders in k
+TASK: build a log-interpolated power spectrum, taking the logarithm of the
+      input here so that callers can pass the raw output of a Boltzmann
+      code
+*/
+ccl_f2d_t *ccl_f2d_t_new_from_pk(int na, double *a_arr,
+                                 int nk, double *lk_arr,
+                                 double *pk_arr,
+                                 int extrap_order_lok,
+                                 int extrap_order_hik,
+                                 int *status)
+{
+  int ii;
+  int nonpositive = 0;
+  ccl_f2d_t *f2d = NULL;
+  double *lpk_arr = malloc(na*nk*sizeof(double));
+
+  if(lpk_arr == NULL) {
+    *status = CCL_ERROR_MEMORY;
+    return NULL;
+  }
+
+  #pragma omp simd reduction(|:nonpositive)
+  for(ii=0; ii<na*nk; ii++) {
+    nonpositive |= !(pk_arr[ii] > 0);
+    lpk_arr[ii] = log(pk_arr[ii]);
+  }
+
+  if(nonpositive)
+    *status = CCL_ERROR_INCONSISTENT;
+  else
+    f2d = ccl_f2d_t_new(na, a_arr, nk, lk_arr, lpk_arr, NULL, NULL, 0,
+                        extrap_order_lok, extrap_order_hik,
+                        ccl_f2d_cclgrowth, 1, 0, 2, ccl_f2d_3, status);
+
+  free(lpk_arr);
+  return f2d;
+}
+
 void ccl_f2d_t_free(ccl_f2d_t *f2d)
 {
   if(f2d != NULL) {
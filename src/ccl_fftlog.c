@@ -9,6 +9,14 @@
 #include <gsl/gsl_sf_gamma.h>
 #include "ccl.h"
 
+#ifdef _OPENMP
+#include "omp.h"
+#endif
+
+// Smallest transform size for which a single FFT is split across threads.
+// Below this, the threading overhead outweighs the gain.
+#define CCL_FFTLOG_NMIN_THREADS 16384
+
 
 /****************************************************************
 
@@ -196,6 +204,53 @@ static void compute_u_coefficients_new_deriv(int N, double mu, double q, double
 }
 
 
+/* Number of threads each FFT should use when transforming npk functions of
+ * size N. Transforms are normally distributed across threads. FFTW threads
+ * are only used when there are fewer functions than threads, the
+ * transforms are large, and we are not already inside a parallel region.
+ * In that case the functions are transformed one after the other. */
+static int fftlog_nthreads(int npk, int N)
+{
+#if defined(_OPENMP) && defined(HAVE_FFTW3_OMP)
+  static int threads_initialized = 0;
+  int nth = omp_get_max_threads();
+
+  if((nth <= 1) || (npk >= nth) || (N < CCL_FFTLOG_NMIN_THREADS) ||
+     omp_in_parallel())
+    return 1;
+
+  #pragma omp critical(ccl_fftlog_threads)
+  {
+    if(!threads_initialized)
+      threads_initialized = fftw_init_threads();
+  }
+  if(!threads_initialized)
+    return 1;
+  return nth;
+#else
+  return 1;
+#endif
+}
+
+/* Plan the forward and reverse FFTs of the convolution b = a*u, using
+ * nthreads threads per FFT. */
+static void fftlog_plan(int N, fftw_complex *a_tmp, fftw_complex *b_tmp,
+                        int nthreads, fftw_plan *forward_plan,
+                        fftw_plan *reverse_plan)
+{
+#if defined(_OPENMP) && defined(HAVE_FFTW3_OMP)
+  if(nthreads > 1)
+    fftw_plan_with_nthreads(nthreads);
+#endif
+  *forward_plan = fftw_plan_dft_1d(N, a_tmp, b_tmp, -1, FFTW_ESTIMATE);
+  *reverse_plan = fftw_plan_dft_1d(N, b_tmp, b_tmp, +1, FFTW_ESTIMATE);
+#if defined(_OPENMP) && defined(HAVE_FFTW3_OMP)
+  // Restore the default for any other plans
+  if(nthreads > 1)
+    fftw_plan_with_nthreads(1);
+#endif
+}
+
 /* Compute the discrete Hankel transform of the function a(r).  See the FFTLog
  * documentation (or the Fortran routine of the same name in the FFTLog
  * sources) for a description of exactly what this function computes.
@@ -209,6 +264,7 @@ static void fht(int npk, int N,
     int noring, double complex* u, int *status)
 {
   fftw_plan forward_plan, reverse_plan;
+  int nthreads = 1;
   double L = log(k[N-1]/k[0]) * N/(N-1.);
   double complex* ulocal = NULL;
   if(u == NULL) {
@@ -240,18 +296,13 @@ static void fht(int npk, int N,
 
   if(*status == 0) {
     /* Compute the convolution b = a*u using FFTs */
-    forward_plan = fftw_plan_dft_1d(N,
-                                    (fftw_complex*) a_tmp,
-                                    (fftw_complex*) b_tmp,
-                                    -1, FFTW_ESTIMATE);
-    reverse_plan = fftw_plan_dft_1d(N,
-                                    (fftw_complex*) b_tmp,
-                                    (fftw_complex*) b_tmp,
-                                    +1, FFTW_ESTIMATE);
+    nthreads = fftlog_nthreads(npk, N);
+    fftlog_plan(N, a_tmp, b_tmp, nthreads, &forward_plan, &reverse_plan);
   }
 
   if(*status == 0) {
-    #pragma omp parallel default(none) \
+    // If each FFT is threaded, the functions are transformed serially
+    #pragma omp parallel if(nthreads == 1) default(none) \
                          shared(npk, N, k, pk, r, xi, \
                                 dim, mu, q, kcrc, u, status, \
                                 forward_plan, reverse_plan, \
@@ -291,8 +342,9 @@ static void fht(int npk, int N,
         for(int i = 0; i < N; i++)
           prefac_pk[i] = pow(k[i], dim/2-q);
 
-        /* Compute k's corresponding to input r's */
-        double k0r0 = kcrc * exp(-L);
+        /* Compute k's corresponding to input r's, such that
+         * k[n]*r[N-1-n] = kcrc */
+        double k0r0 = kcrc * exp(-L*(N-1.)/N);
         r[0] = k0r0/k[0];
         for(int n = 1; n < N; n++)
           r[n] = r[0] * exp(n*L/N);
@@ -370,6 +422,7 @@ static void general_fht(int npk, int N,
   mu = mu+0.5*spherical_bessel;
 
   fftw_plan forward_plan, reverse_plan;
+  int nthreads = 1;
   double L = log(k[N-1]/k[0]) * N/(N-1.);
   double complex* ulocal = NULL;
   if(u == NULL) {
@@ -401,18 +454,13 @@ static void general_fht(int npk, int N,
 
   if(*status == 0) {
     /* Compute the convolution b = a*u using FFTs */
-    forward_plan = fftw_plan_dft_1d(N,
-                                    (fftw_complex*) a_tmp,
-                                    (fftw_complex*) b_tmp,
-                                    -1, FFTW_ESTIMATE);
-    reverse_plan = fftw_plan_dft_1d(N,
-                                    (fftw_complex*) b_tmp,
-                                    (fftw_complex*) b_tmp,
-                                    +1, FFTW_ESTIMATE);
+    nthreads = fftlog_nthreads(npk, N);
+    fftlog_plan(N, a_tmp, b_tmp, nthreads, &forward_plan, &reverse_plan);
   }
 
   if(*status == 0) {
-    #pragma omp parallel default(none) \
+    // If each FFT is threaded, the functions are transformed serially
+    #pragma omp parallel if(nthreads == 1) default(none) \
                          shared(npk, N, k, pk, r, xi, \
                                 spherical_bessel, bessel_deriv, mu, q, kcrc, u, status, plaw, \
                                 forward_plan, reverse_plan, \
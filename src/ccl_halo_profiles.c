@@ -0,0 +1,485 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_sf_expint.h>
+#include <gsl/gsl_spline.h>
+
+#include "ccl.h"
+
+// Scale-dependent factor of the GNFW profile
+static double gnfw_form_factor(double x, double alpha, double beta,
+                               double gamma, double c500) {
+  double cx = c500*x;
+  return pow(cx, -gamma)*pow(1+pow(cx, alpha), (gamma-beta)/alpha);
+}
+
+/* ------- ROUTINE: ccl_gnfw_fourier_table ------
+INPUTS: GNFW shape parameters, truncation radius, FFTLog sampling,
+        values of q at which to evaluate the template
+TASK: compute F(q) = \int dx x^2 p(x) j_0(qx) with a single 3D FFTLog
+      transform, and interpolate it onto q_arr.
+*/
+void ccl_gnfw_fourier_table(double alpha, double beta, double gamma,
+                            double c500, double x_out,
+                            double padding_lo, double padding_hi,
+                            double n_per_decade,
+                            int nq, double *q_arr, double *fq_arr,
+                            int *status) {
+  int ix, iq, nx;
+  double lxmin, lxmax, dlx, epsilon;
+  double *x_arr = NULL, *px_arr = NULL, *r_arr = NULL, *xi_arr = NULL;
+  gsl_spline *spl = NULL;
+  gsl_interp_accel *ia = NULL;
+
+  if ((nq < 1) || (q_arr[0] <= 0) || (q_arr[nq-1] < q_arr[0])) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return;
+  }
+
+  // x grid covering 1/q for all q, with some padding on both sides
+  lxmin = log(padding_lo/q_arr[nq-1]);
+  lxmax = log(padding_hi/q_arr[0]);
+  nx = (int)(n_per_decade*(lxmax-lxmin)/M_LN10)+1;
+  dlx = (lxmax-lxmin)/(nx-1.);
+
+  x_arr = ccl_workspace_get_doubles(nx);
+  px_arr = ccl_workspace_get_doubles(nx);
+  r_arr = ccl_workspace_get_doubles(nx);
+  xi_arr = ccl_workspace_get_doubles(nx);
+  if ((x_arr == NULL) || (px_arr == NULL) ||
+      (r_arr == NULL) || (xi_arr == NULL))
+    *status = CCL_ERROR_MEMORY;
+
+  if (*status == 0) {
+    for (ix=0; ix < nx; ix++) {
+      double lx = lxmin+ix*dlx;
+      // Fraction of the log-x cell lying within x_out. This avoids
+      // aliasing the sharp truncation onto the nearest grid point.
+      double w = 1;
+      if (isfinite(x_out))
+        w = fmax(0, fmin(1, (log(x_out)-lx)/dlx+0.5));
+      x_arr[ix] = exp(lx);
+      if (w > 0)
+        px_arr[ix] = w*gnfw_form_factor(x_arr[ix], alpha, beta, gamma, c500);
+      else
+        px_arr[ix] = 0;
+    }
+
+    // Bias so that x^{3/2-epsilon} p(x) decays as fast at both ends
+    epsilon = 1.5-0.5*(gamma+beta);
+    ccl_fftlog_ComputeXi3D(0, epsilon, 1, nx, x_arr, &px_arr,
+                           r_arr, &xi_arr, status);
+  }
+
+  if (*status == 0) {
+    // ComputeXi3D includes a 1/(2 pi^2) factor
+    for (ix=0; ix < nx; ix++) {
+      r_arr[ix] = log(r_arr[ix]);
+      xi_arr[ix] *= 2*M_PI*M_PI;
+    }
+
+    spl = ccl_workspace_get_spline(gsl_interp_cspline, nx, &ia);
+    if (spl == NULL)
+      *status = CCL_ERROR_MEMORY;
+  }
+
+  if (*status == 0) {
+    if (gsl_spline_init(spl, r_arr, xi_arr, nx))
+      *status = CCL_ERROR_SPLINE;
+  }
+
+  if (*status == 0) {
+    for (iq=0; iq < nq; iq++) {
+      if (gsl_spline_eval_e(spl, log(q_arr[iq]), ia, &(fq_arr[iq]))) {
+        *status = CCL_ERROR_SPLINE_EV;
+        break;
+      }
+    }
+  }
+
+  ccl_workspace_put_spline(spl, ia);
+  ccl_workspace_put_doubles(xi_arr);
+  ccl_workspace_put_doubles(r_arr);
+  ccl_workspace_put_doubles(px_arr);
+  ccl_workspace_put_doubles(x_arr);
+}
+
+// Einasto profile shape, normalized to e^{2/alpha} at x=0
+static double einasto_shape(double x, double alpha) {
+  return exp(-2*(pow(x, alpha)-1)/alpha);
+}
+
+// Interpolate ny tables y_in[iy], sampled at ascending values of
+// log(x) lx_in, onto x_out. Results are stored contiguously in y_out.
+static void interpolate_tables(int ny, int n_in, double *lx_in, double **y_in,
+                               int n_out, double *x_out, double *y_out,
+                               int *status) {
+  int iy, ix;
+  gsl_spline *spl = NULL;
+  gsl_interp_accel *ia = NULL;
+
+  spl = ccl_workspace_get_spline(gsl_interp_cspline, n_in, &ia);
+  if (spl == NULL) {
+    *status = CCL_ERROR_MEMORY;
+    return;
+  }
+
+  for (iy=0; iy < ny; iy++) {
+    if (gsl_spline_init(spl, lx_in, y_in[iy], n_in)) {
+      *status = CCL_ERROR_SPLINE;
+      break;
+    }
+    gsl_interp_accel_reset(ia);
+    for (ix=0; ix < n_out; ix++) {
+      if (gsl_spline_eval_e(spl, log(x_out[ix]), ia,
+                            &(y_out[iy*n_out+ix]))) {
+        *status = CCL_ERROR_SPLINE_EV;
+        break;
+      }
+    }
+    if (*status)
+      break;
+  }
+
+  ccl_workspace_put_spline(spl, ia);
+}
+
+/* ------- ROUTINE: ccl_einasto_tables ------
+INPUTS: values of the Einasto index, FFTLog sampling, values of q and X
+        at which to evaluate the Fourier and projected templates
+TASK: compute F(q) = \int dx x^2 e(x) j_0(qx) for all alphas with a single
+      3D FFTLog pass, and S(X) = 2 \int dq q F(q) J_0(qX) from it with a
+      single 2D FFTLog pass, then interpolate them onto q_arr and x_arr.
+*/
+void ccl_einasto_tables(int nalpha, double *alpha_arr,
+                        double padding_lo, double padding_hi,
+                        double n_per_decade,
+                        int nq, double *q_arr, double *fq_arr,
+                        int nx, double *x_arr, double *sx_arr,
+                        int *status) {
+  int ia, i, nr;
+  double lrmin, lrmax, dlr;
+  double *r_arr = NULL, *k_arr = NULL, *rp_arr = NULL;
+  double **er = NULL, **fk = NULL, **sr = NULL;
+
+  if ((nalpha < 1) || (nq < 1) || (q_arr[0] <= 0) ||
+      (q_arr[nq-1] < q_arr[0]) ||
+      ((nx > 0) && ((x_arr[0] <= 0) || (x_arr[nx-1] < x_arr[0])))) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return;
+  }
+  for (ia=0; ia < nalpha; ia++) {
+    if (alpha_arr[ia] <= 0) {
+      *status = CCL_ERROR_INCONSISTENT;
+      return;
+    }
+  }
+
+  // Real-space grid covering 1/q for all q and, after the second
+  // transform, all X, with some padding on both sides.
+  lrmin = log(padding_lo/q_arr[nq-1]);
+  lrmax = log(padding_hi/q_arr[0]);
+  if (nx > 0) {
+    lrmin = fmin(lrmin, log(padding_lo*x_arr[0]));
+    lrmax = fmax(lrmax, log(padding_hi*x_arr[nx-1]));
+  }
+  nr = (int)(n_per_decade*(lrmax-lrmin)/M_LN10)+1;
+  dlr = (lrmax-lrmin)/(nr-1.);
+
+  r_arr = malloc(nr*sizeof(double));
+  k_arr = malloc(nr*sizeof(double));
+  rp_arr = malloc(nr*sizeof(double));
+  er = calloc(nalpha, sizeof(double *));
+  fk = calloc(nalpha, sizeof(double *));
+  sr = calloc(nalpha, sizeof(double *));
+  if ((r_arr == NULL) || (k_arr == NULL) || (rp_arr == NULL) ||
+      (er == NULL) || (fk == NULL) || (sr == NULL))
+    *status = CCL_ERROR_MEMORY;
+
+  if (*status == 0) {
+    for (ia=0; ia < nalpha; ia++) {
+      er[ia] = malloc(nr*sizeof(double));
+      fk[ia] = malloc(nr*sizeof(double));
+      sr[ia] = malloc(nr*sizeof(double));
+      if ((er[ia] == NULL) || (fk[ia] == NULL) || (sr[ia] == NULL))
+        *status = CCL_ERROR_MEMORY;
+    }
+  }
+
+  if (*status == 0) {
+    for (i=0; i < nr; i++)
+      r_arr[i] = exp(lrmin+i*dlr);
+    for (ia=0; ia < nalpha; ia++) {
+      for (i=0; i < nr; i++)
+        er[ia][i] = einasto_shape(r_arr[i], alpha_arr[ia]);
+    }
+
+    // The profile is flat (and large, e^{2/alpha}) at small x, so it
+    // is weighted by x^2 rather than x^{3/2}. F(q) is flat at small q
+    // and decays as q^{-3-alpha}, so the 2D transform needs no bias.
+    ccl_fftlog_ComputeXi3D(0, -0.5, nalpha, nr, r_arr, er,
+                           k_arr, fk, status);
+  }
+
+  if (*status == 0) {
+    // ComputeXi3D includes a 1/(2 pi^2) factor
+    for (ia=0; ia < nalpha; ia++) {
+      for (i=0; i < nr; i++)
+        fk[ia][i] *= 2*M_PI*M_PI;
+    }
+  }
+
+  if ((*status == 0) && (nx > 0)) {
+    // ComputeXi2D includes a 1/(2 pi) factor
+    ccl_fftlog_ComputeXi2D(0, 0., nalpha, nr, k_arr, fk,
+                           rp_arr, sr, status);
+    for (ia=0; ia < nalpha; ia++) {
+      for (i=0; i < nr; i++)
+        sr[ia][i] *= 4*M_PI;
+    }
+  }
+
+  if (*status == 0) {
+    for (i=0; i < nr; i++)
+      k_arr[i] = log(k_arr[i]);
+    interpolate_tables(nalpha, nr, k_arr, fk, nq, q_arr, fq_arr, status);
+  }
+  if ((*status == 0) && (nx > 0)) {
+    for (i=0; i < nr; i++)
+      rp_arr[i] = log(rp_arr[i]);
+    interpolate_tables(nalpha, nr, rp_arr, sr, nx, x_arr, sx_arr, status);
+  }
+
+  for (ia=0; ia < nalpha; ia++) {
+    if (er != NULL)
+      free(er[ia]);
+    if (fk != NULL)
+      free(fk[ia]);
+    if (sr != NULL)
+      free(sr[ia]);
+  }
+  free(er);
+  free(fk);
+  free(sr);
+  free(rp_arr);
+  free(k_arr);
+  free(r_arr);
+}
+
+// atan(sqrt(u))/sqrt(u) for u>0, and atanh(sqrt(-u))/sqrt(-u) for u<0.
+// Both branches are the same analytic function of u = x^2-1, and the
+// closed forms below only involve it through this combination.
+#pragma omp declare simd
+static double hernquist_atan_ratio(double u) {
+  if(u > 0)
+    return atan(sqrt(u))/sqrt(u);
+  return atanh(sqrt(-u))/sqrt(-u);
+}
+
+// Dimensionless projected Hernquist profile, Sigma(R) = 2 r_s rho_0 f(x).
+// Close to x=1 the closed form suffers from cancellations, so its Taylor
+// series in u = x^2-1 is used instead.
+#pragma omp declare simd
+static double hernquist_fx_projected(double x) {
+  int n;
+  double u = x*x-1, un = 1, f = 0;
+
+  if(fabs(u) < 0.1) {
+    for(n=2; n<16; n++) {
+      f += (n%2 ? -0.5 : 0.5)*(3./(2*n+1)-1./(2*n-1))*un;
+      un *= u;
+    }
+    return f;
+  }
+  return ((u+3)*hernquist_atan_ratio(u)-3)/(2*u*u);
+}
+
+// Dimensionless cumulative surface density of the Hernquist profile,
+// Sigma(<R) = 2 r_s rho_0 f(x), with the same series close to x=1.
+#pragma omp declare simd
+static double hernquist_fx_cumul2d(double x) {
+  int n;
+  double u = x*x-1, un = u, f = 1./3.;
+
+  if(fabs(u) < 0.1) {
+    for(n=2; n<16; n++) {
+      f += (n%2 ? -2. : 2.)/((2*n-1)*(2*n+1))*un;
+      un *= u;
+    }
+    return f/(x*x);
+  }
+  return (1+(1-(u+1)*hernquist_atan_ratio(u))/u)/(x*x);
+}
+
+// Fourier-space Hernquist profile in units of its total mass
+// M (1+c)^2/c^2, for x = k r_s. At large x, where the closed form suffers
+// from cancellations, its asymptotic expansion is used instead.
+static double hernquist_fx_fourier(double x) {
+  int n;
+  double f, xm2, term;
+
+  if(x <= 0)
+    return 1;
+  if(x > 40) {
+    xm2 = 1/(x*x);
+    term = 2*xm2;
+    f = 0;
+    for(n=1; n<9; n++) {
+      f += term;
+      term *= -(2*n+1)*(2*n+2)*xm2;
+    }
+    return f;
+  }
+  return 1-x*(sin(x)*gsl_sf_Ci(x)-cos(x)*(gsl_sf_Si(x)-M_PI_2));
+}
+
+// Fourier-space Hernquist profile truncated at x = c, in units of M.
+static double hernquist_fx_fourier_trunc(double x, double c) {
+  double cp1 = c+1;
+  double f2, f3;
+
+  if(x <= 0)
+    return 1;
+  f2 = (x*sin(x)*(gsl_sf_Ci(cp1*x)-gsl_sf_Ci(x)) -
+        x*cos(x)*(gsl_sf_Si(cp1*x)-gsl_sf_Si(x)));
+  f3 = -1+sin(c*x)/(cp1*cp1*x)+cos(c*x)/cp1;
+  return cp1*cp1*(f2-f3)/(c*c);
+}
+
+/* ------- ROUTINE: ccl_hernquist_profile ------
+INPUTS: kind of profile, whether it is truncated at r = c r_s, number of
+        masses, masses, scale radii and concentrations, number of radii
+        (or wavenumbers) and their values
+TASK: evaluate the real-space, projected, cumulative projected or
+      Fourier-space Hernquist profile for all masses and radii
+*/
+void ccl_hernquist_profile(ccl_hernquist_profile_t kind, int truncated,
+                           int nM, double *M_arr, double *rs_arr,
+                           double *c_arr, int nr, double *r_arr,
+                           double *prof, int *status) {
+  if((nM <= 0) || (nr <= 0)) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return;
+  }
+  if(truncated && ((kind == ccl_hernquist_projected) ||
+                   (kind == ccl_hernquist_cumul2d))) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return;
+  }
+
+  #pragma omp parallel default(none) \
+                       shared(kind, truncated, nM, M_arr, rs_arr, c_arr, \
+                              nr, r_arr, prof)
+  {
+    int iM, ir;
+
+    #pragma omp for
+    for(iM=0; iM<nM; iM++) {
+      double rs = rs_arr[iM];
+      double c = c_arr[iM];
+      double mtot = M_arr[iM]*(1+c)*(1+c)/(c*c);
+      double rho0 = mtot/(2*M_PI*rs*rs*rs);
+      double *p = &(prof[iM*nr]);
+
+      switch(kind) {
+      case ccl_hernquist_real:
+        #pragma omp simd
+        for(ir=0; ir<nr; ir++) {
+          double x = r_arr[ir]/rs;
+          p[ir] = ((truncated && (x > c)) ? 0 :
+                   rho0/(x*(1+x)*(1+x)*(1+x)));
+        }
+        break;
+      case ccl_hernquist_projected:
+        #pragma omp simd
+        for(ir=0; ir<nr; ir++)
+          p[ir] = 2*rs*rho0*hernquist_fx_projected(r_arr[ir]/rs);
+        break;
+      case ccl_hernquist_cumul2d:
+        #pragma omp simd
+        for(ir=0; ir<nr; ir++)
+          p[ir] = 2*rs*rho0*hernquist_fx_cumul2d(r_arr[ir]/rs);
+        break;
+      case ccl_hernquist_fourier:
+        // Si and Ci are not vectorisable, so no simd here.
+        if(truncated) {
+          for(ir=0; ir<nr; ir++)
+            p[ir] = M_arr[iM]*hernquist_fx_fourier_trunc(r_arr[ir]*rs, c);
+        }
+        else {
+          for(ir=0; ir<nr; ir++)
+            p[ir] = mtot*hernquist_fx_fourier(r_arr[ir]*rs);
+        }
+        break;
+      }
+    } //end omp for
+  } //end omp parallel
+}
+
+// Rows of the first profile handled by each call to dgemm
+#define HALOMOD_OUTER_BLOCK 64
+
+/* ------- ROUTINE: ccl_halomod_mass_outer ------
+INPUTS: number of masses, mass integration weights, two sets of
+        Fourier-space profiles sampled at nk1 and nk2 wavenumbers
+TASK: compute I(k,k') = \sum_M w(M) u_1(k|M) u_2(k'|M) as a sequence of
+      (block x nM) x (nM x nk2) matrix products, so that the
+      (nk1, nk2, nM) integrand is never stored
+*/
+void ccl_halomod_mass_outer(int nM, double *w_arr,
+                            int nk1, double *u1_arr,
+                            int nk2, double *u2_arr,
+                            double *out, int *status) {
+  if((nM <= 0) || (nk1 <= 0) || (nk2 <= 0)) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return;
+  }
+
+  int nblocks = (nk1+HALOMOD_OUTER_BLOCK-1)/HALOMOD_OUTER_BLOCK;
+
+  #pragma omp parallel default(none) \
+                       shared(nM, w_arr, nk1, u1_arr, nk2, u2_arr, \
+                              out, nblocks, status)
+  {
+    int ib, ik, iM;
+    int local_status = 0;
+    double *wu1 = ccl_workspace_get_doubles(HALOMOD_OUTER_BLOCK*nM);
+    gsl_matrix_const_view u2 = gsl_matrix_const_view_array(u2_arr, nk2, nM);
+
+    if(wu1 == NULL)
+      local_status = CCL_ERROR_MEMORY;
+
+    #pragma omp for
+    for(ib=0; ib<nblocks; ib++) {
+      if(local_status)
+        continue;
+
+      int ik0 = ib*HALOMOD_OUTER_BLOCK;
+      int nk = nk1-ik0 < HALOMOD_OUTER_BLOCK ? nk1-ik0 : HALOMOD_OUTER_BLOCK;
+
+      // Fold the weights into this block of the first profile
+      for(ik=0; ik<nk; ik++) {
+        double *u = &(u1_arr[(ik0+ik)*nM]);
+        double *wu = &(wu1[ik*nM]);
+        #pragma omp simd
+        for(iM=0; iM<nM; iM++)
+          wu[iM] = w_arr[iM]*u[iM];
+      }
+
+      gsl_matrix_view a = gsl_matrix_view_array(wu1, nk, nM);
+      gsl_matrix_view c = gsl_matrix_view_array(&(out[ik0*nk2]), nk, nk2);
+      if(gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1., &(a.matrix),
+                        &(u2.matrix), 0., &(c.matrix)))
+        local_status = CCL_ERROR_ONE_HALO_INT;
+    } //end omp for
+
+    ccl_workspace_put_doubles(wu1);
+
+    if(local_status) {
+      #pragma omp atomic write
+      *status = local_status;
+    }
+  } //end omp parallel
+}
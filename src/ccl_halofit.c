@@ -133,7 +133,7 @@ static double get_w0eff(double a, struct hf_model_match_data data) {
   }
 
   T = gsl_root_fsolver_brent;
-  s = gsl_root_fsolver_alloc(T);
+  s = ccl_workspace_get_root_fsolver(T);
   if (s == NULL) {
     *(data.status) = CCL_ERROR_MEMORY;
   }
@@ -157,7 +157,7 @@ static double get_w0eff(double a, struct hf_model_match_data data) {
         1e-6);
     } while (gsl_status == GSL_CONTINUE && itr < max_itr);
 
-    gsl_root_fsolver_free(s);
+    ccl_workspace_put_root_fsolver(s);
 
     if (gsl_status != GSL_SUCCESS || itr >= max_itr) {
       ccl_raise_gsl_warning(
@@ -277,7 +277,7 @@ static double get_rsigma(double a, struct hf_int_data data) {
   }
 
   T = gsl_root_fsolver_brent;
-  s = gsl_root_fsolver_alloc(T);
+  s = ccl_workspace_get_root_fsolver(T);
   if (s == NULL) {
     *(data.status) = CCL_ERROR_MEMORY;
   }
@@ -301,7 +301,7 @@ static double get_rsigma(double a, struct hf_int_data data) {
         data.cosmo->gsl_params.INTEGRATION_SIGMAR_EPSREL);
     } while (gsl_status == GSL_CONTINUE && itr < max_itr);
 
-    gsl_root_fsolver_free(s);
+    ccl_workspace_put_root_fsolver(s);
 
     if (gsl_status != GSL_SUCCESS || itr >= max_itr) {
       ccl_raise_gsl_warning(
@@ -381,7 +381,7 @@ halofit_struct* ccl_halofit_struct_new(ccl_cosmology *cosmo,
   }
 
   if (*status == 0) {
-    workspace = gsl_integration_cquad_workspace_alloc(cosmo->gsl_params.N_ITERATION);
+    workspace = ccl_workspace_get_cquad(cosmo->gsl_params.N_ITERATION);
     if (workspace == NULL) {
       *status = CCL_ERROR_MEMORY;
       ccl_cosmology_set_status_message(
@@ -773,7 +773,8 @@ halofit_struct* ccl_halofit_struct_new(ccl_cosmology *cosmo,
     ccl_halofit_struct_free(hf);
     hf = NULL;
   }
-  gsl_integration_cquad_workspace_free(workspace);
+  ccl_workspace_put_cquad(workspace);
+  ccl_workspace_release();
   free(vals);
   free(vals_om);
   free(vals_de);
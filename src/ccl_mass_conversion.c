@@ -75,22 +75,18 @@ static void nfw_fdf(double x,void *params,
   }
 }
 
-static int convert_concentration_single(double d_factor, double c_old,
+static int convert_concentration_single(gsl_root_fdfsolver *s,
+					double d_factor, double c_old,
 					double *c_new, double c_start)
 {
   double c0, offset = d_factor * nfw_fx(c_old);
   int status, iter=0, max_iter=100;
   gsl_function_fdf FDF;
-  gsl_root_fdfsolver *s=NULL;
   FDF.f = &nfw_f;
   FDF.df = &nfw_df;
   FDF.fdf = &nfw_fdf;
   FDF.params = &offset;
-  
-  s=gsl_root_fdfsolver_alloc(gsl_root_fdfsolver_newton);
-  if (s==NULL)
-    return CCL_ERROR_MEMORY;
-  
+
   gsl_root_fdfsolver_set (s, &FDF, c_start);
   *c_new = c_start;
   do
@@ -103,7 +99,6 @@ static int convert_concentration_single(double d_factor, double c_old,
 
     }
   while (status == GSL_CONTINUE && iter < max_iter);
-  gsl_root_fdfsolver_free (s);
 
   return status;
 }
@@ -117,14 +112,118 @@ void ccl_convert_concentration(ccl_cosmology *cosmo,
 
   int ii,st=0;
   double d_factor = delta_old/delta_new;
+  gsl_root_fdfsolver *s=gsl_root_fdfsolver_alloc(gsl_root_fdfsolver_newton);
+  if (s==NULL) {
+    *status=CCL_ERROR_MEMORY;
+    ccl_cosmology_set_status_message(cosmo,
+      "ccl_mass_conversion.c: ccl_convert_concentration(): "
+      "memory allocation\n");
+    return;
+  }
+
   for(ii=0;ii<nc;ii++) {
-    st=convert_concentration_single(d_factor, c_old[ii], &(c_new[ii]), c_old[ii]);
+    st=convert_concentration_single(s, d_factor, c_old[ii], &(c_new[ii]), c_old[ii]);
     if(st!=GSL_SUCCESS) {
       *status=CCL_ERROR_ROOT;
       ccl_cosmology_set_status_message(cosmo,
         "ccl_mass_conversion.c: ccl_convert_concentration(): "
         "NR solver failed to find a root\n");
-      return;
+      break;
     }
   }
+  gsl_root_fdfsolver_free(s);
+}
+
+// Logarithmic slope of nfw_fx, dlog(f)/dlog(x).
+static double nfw_dlogf(double x)
+{
+  return x*nfw_df(x,NULL)/nfw_fx(x);
+}
+
+/*
+ * ccl_mass_translation_table tabulates the mass M' in a new mass
+ * definition for a grid of masses M (in the old definition) and
+ * scale factors, together with the Jacobian dlog(M')/dlog(M).
+ * Since R' = R c'/c,
+ *    M' = M (c'/c)^3 / d_factor,
+ * where d_factor = Delta Omega / (Delta' Omega'). Differentiating
+ * f(c') = d_factor f(c) gives
+ *    dlog(M')/dlog(M) = 1 + 3 (g(c)/g(c') - 1) dlog(c)/dlog(M),
+ * with g = dlog(f)/dlog(x). The slope of the concentration-mass
+ * relation is obtained by finite differences along the mass grid.
+ */
+void ccl_mass_translation_table(ccl_cosmology *cosmo,
+				int na, double *d_factor_arr,
+				int nM, double *lM_arr, double *c_old_arr,
+				double *lM_new_arr, double *jac_arr,
+				int *status)
+{
+  if((na<=0) || (nM<2)) {
+    *status=CCL_ERROR_INCONSISTENT;
+    ccl_cosmology_set_status_message(cosmo,
+      "ccl_mass_conversion.c: ccl_mass_translation_table(): "
+      "need at least one scale factor and two masses\n");
+    return;
+  }
+
+  #pragma omp parallel default(none) \
+                       shared(na, d_factor_arr, nM, lM_arr, c_old_arr, \
+                              lM_new_arr, jac_arr, status)
+  {
+    int ia, iM, st;
+    int local_status=0;
+    double c_start, dlc, c_new, *c_old, *lM_new, *jac;
+    gsl_root_fdfsolver *s=gsl_root_fdfsolver_alloc(gsl_root_fdfsolver_newton);
+    if(s==NULL)
+      local_status=CCL_ERROR_MEMORY;
+
+    #pragma omp for
+    for(ia=0; ia<na; ia++) {
+      if(local_status)
+        continue;
+      c_old=&(c_old_arr[ia*nM]);
+      lM_new=&(lM_new_arr[ia*nM]);
+      jac=&(jac_arr[ia*nM]);
+      // Warm-start each root from the previous mass, since c'/c
+      // varies slowly along the grid.
+      c_start=c_old[0];
+      for(iM=0; iM<nM; iM++) {
+        st=convert_concentration_single(s, d_factor_arr[ia], c_old[iM],
+                                        &c_new, c_start);
+        if(st!=GSL_SUCCESS) {
+          local_status=CCL_ERROR_ROOT;
+          break;
+        }
+        c_start=c_new*c_old[(iM+1<nM) ? iM+1 : iM]/c_old[iM];
+
+        if(iM==0)
+          dlc=log(c_old[1]/c_old[0])/(lM_arr[1]-lM_arr[0]);
+        else if(iM==nM-1)
+          dlc=log(c_old[iM]/c_old[iM-1])/(lM_arr[iM]-lM_arr[iM-1]);
+        else
+          dlc=log(c_old[iM+1]/c_old[iM-1])/(lM_arr[iM+1]-lM_arr[iM-1]);
+
+        lM_new[iM]=lM_arr[iM]+3*log(c_new/c_old[iM])-log(d_factor_arr[ia]);
+        jac[iM]=1+3*(nfw_dlogf(c_old[iM])/nfw_dlogf(c_new)-1)*dlc;
+      }
+    } //end omp for
+    if(s!=NULL)
+      gsl_root_fdfsolver_free(s);
+
+    if(local_status) {
+      #pragma omp atomic write
+      *status=local_status;
+    }
+  } //end omp parallel
+
+  if(*status==CCL_ERROR_MEMORY) {
+    ccl_cosmology_set_status_message(cosmo,
+      "ccl_mass_conversion.c: ccl_mass_translation_table(): "
+      "memory allocation\n");
+  }
+  else if(*status) {
+    ccl_cosmology_set_status_message(cosmo,
+      "ccl_mass_conversion.c: ccl_mass_translation_table(): "
+      "NR solver failed to find a root\n");
+  }
 }
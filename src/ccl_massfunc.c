@@ -90,6 +90,7 @@ void ccl_cosmology_compute_sigma(ccl_cosmology *cosmo, ccl_f2d_t *psp, int *stat
                                        psp, &local_status));
         }
       } //end omp for
+      ccl_workspace_release();
       if (local_status) {
         #pragma omp atomic write
         *status = local_status;
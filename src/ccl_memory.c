@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gsl/gsl_spline.h>
+#include <gsl/gsl_interp2d.h>
+#include <gsl/gsl_spline2d.h>
+
+#include "ccl.h"
+
+/* ------- ROUTINE: interp_state_ndoubles ------
+INPUTS: interpolation type, number of knots
+TASK: return the number of doubles held by the internal state of a
+      GSL 1D interpolator. These mirror the allocations made in GSL's
+      akima.c, cspline.c and steffen.c. Unknown types are assumed to
+      carry no state.
+*/
+static size_t interp_state_ndoubles(const gsl_interp_type *T, size_t n)
+{
+  if(T == NULL)
+    return 0;
+  if(!strcmp(T->name, "akima") || !strcmp(T->name, "akima-periodic"))
+    return 4*n+4; // b, c, d and _m (n+4)
+  if(!strcmp(T->name, "cspline") || !strcmp(T->name, "cspline-periodic"))
+    return 4*n; // c, g, diag and offdiag
+  if(!strcmp(T->name, "steffen"))
+    return 5*n; // a, b, c, d and y_prime
+  return 0;
+}
+
+size_t ccl_gsl_spline_size(gsl_spline *spl)
+{
+  if(spl == NULL)
+    return 0;
+
+  size_t n = spl->size;
+  size_t size = sizeof(gsl_spline) + 2*n*sizeof(double); // x and y
+  if(spl->interp != NULL) {
+    size += sizeof(gsl_interp);
+    size += interp_state_ndoubles(spl->interp->type, n)*sizeof(double);
+  }
+  return size;
+}
+
+size_t ccl_gsl_spline2d_size(gsl_spline2d *spl)
+{
+  if(spl == NULL)
+    return 0;
+
+  size_t nx = spl->interp_object.xsize;
+  size_t ny = spl->interp_object.ysize;
+  size_t size = sizeof(gsl_spline2d) + (nx+ny+nx*ny)*sizeof(double);
+  // Bicubic interpolation stores the three derivatives zx, zy and zxy
+  // at every knot. Bilinear interpolation carries no state.
+  if((spl->interp_object.type != NULL) &&
+     (!strcmp(spl->interp_object.type->name, "bicubic")))
+    size += 3*nx*ny*sizeof(double);
+  return size;
+}
+
+size_t ccl_f1d_t_size(ccl_f1d_t *spl)
+{
+  if(spl == NULL)
+    return 0;
+  return sizeof(ccl_f1d_t) + ccl_gsl_spline_size(spl->spline);
+}
+
+size_t ccl_f2d_t_size(ccl_f2d_t *f2d)
+{
+  if(f2d == NULL)
+    return 0;
+  return (sizeof(ccl_f2d_t) +
+          ccl_gsl_spline_size(f2d->fk) +
+          ccl_gsl_spline_size(f2d->fa) +
+          ccl_gsl_spline2d_size(f2d->fka));
+}
+
+size_t ccl_f3d_t_size(ccl_f3d_t *f3d)
+{
+  if(f3d == NULL)
+    return 0;
+
+  size_t size = sizeof(ccl_f3d_t);
+  size += f3d->na*sizeof(double); // a_arr
+  size += ccl_f2d_t_size(f3d->fka_1);
+  size += ccl_f2d_t_size(f3d->fka_2);
+  if(f3d->tkka != NULL) {
+    int ia;
+    // See ccl_f3d_t_new for the size of this array
+    size += f3d->na*sizeof(gsl_spline2d);
+    for(ia=0; ia<f3d->na; ia++)
+      size += ccl_gsl_spline2d_size(f3d->tkka[ia]);
+  }
+  return size;
+}
+
+size_t ccl_cl_tracer_t_size(ccl_cl_tracer_t *tr)
+{
+  if(tr == NULL)
+    return 0;
+  return (sizeof(ccl_cl_tracer_t) +
+          ccl_f1d_t_size(tr->kernel) +
+          ccl_f2d_t_size(tr->transfer));
+}
+
+size_t ccl_cl_tracer_collection_t_size(ccl_cl_tracer_collection_t *trc)
+{
+  if(trc == NULL)
+    return 0;
+
+  int itr;
+  size_t size = sizeof(ccl_cl_tracer_collection_t);
+  size += CCL_MAX_TRACERS_PER_COLLECTION*sizeof(ccl_cl_tracer_t *);
+  for(itr=0; itr < trc->n_tracers; itr++)
+    size += ccl_cl_tracer_t_size(trc->ts[itr]);
+  return size;
+}
+
+/* ------- ROUTINE: ccl_memory_report ------
+INPUTS: ccl_cosmology *cosmo
+TASK: walk the splines held in cosmo->data and report their size in bytes
+*/
+void ccl_memory_report(ccl_cosmology *cosmo, ccl_memory_report_t *report)
+{
+  ccl_data *data = &(cosmo->data);
+
+  report->params = cosmo->params.N_nu_mass*sizeof(double);
+  if(cosmo->params.has_mgrowth)
+    report->params += 2*cosmo->params.nz_mgrowth*sizeof(double);
+
+  report->background = (ccl_gsl_spline_size(data->chi) +
+                        ccl_gsl_spline_size(data->E) +
+                        ccl_gsl_spline_size(data->achi) +
+                        ccl_gsl_spline_size(data->Om) +
+                        ccl_gsl_spline_size(data->Delta_vir));
+  report->growth = (ccl_gsl_spline_size(data->growth) +
+                    ccl_gsl_spline_size(data->fgrowth));
+  report->sigma = ccl_gsl_spline2d_size(data->logsigma);
+  report->rsd = (ccl_f1d_t_size(data->rsd_splines[0]) +
+                 ccl_f1d_t_size(data->rsd_splines[1]) +
+                 ccl_f1d_t_size(data->rsd_splines[2]));
+
+  report->total = (sizeof(ccl_cosmology) +
+                   report->params +
+                   report->background +
+                   report->growth +
+                   report->sigma +
+                   report->rsd);
+}
@@ -320,7 +320,7 @@ double ccl_sigma2B(ccl_cosmology *cosmo,double R,double a,ccl_f2d_t *psp, int *s
   F.params=&par;
   double sigma_B;
 
-  workspace = gsl_integration_cquad_workspace_alloc(cosmo->gsl_params.N_ITERATION);
+  workspace = ccl_workspace_get_cquad(cosmo->gsl_params.N_ITERATION);
   if (workspace == NULL) {
     *status = CCL_ERROR_MEMORY;
   }
@@ -335,7 +335,7 @@ double ccl_sigma2B(ccl_cosmology *cosmo,double R,double a,ccl_f2d_t *psp, int *s
       *status |= gslstatus;
     }
   }
-  gsl_integration_cquad_workspace_free(workspace);
+  ccl_workspace_put_cquad(workspace);
 
   return sigma_B*M_LN10/(2*M_PI);
 }
@@ -353,6 +353,7 @@ void ccl_sigma2Bs(ccl_cosmology *cosmo,int na, double *a, double *R,
       if(local_status==0)
         sigma2B_out[ia]=ccl_sigma2B(cosmo,R[ia],a[ia],psp,&local_status);
     } //end omp for
+    ccl_workspace_release();
     if(local_status) {
       #pragma omp atomic write
       *status=local_status;
@@ -433,7 +434,7 @@ double ccl_sigmaR(ccl_cosmology *cosmo,double R,double a,ccl_f2d_t *psp, int *st
   F.params=&par;
   double sigma_R;
 
-  workspace = gsl_integration_cquad_workspace_alloc(cosmo->gsl_params.N_ITERATION);
+  workspace = ccl_workspace_get_cquad(cosmo->gsl_params.N_ITERATION);
   if (workspace == NULL) {
     *status = CCL_ERROR_MEMORY;
   }
@@ -448,7 +449,7 @@ double ccl_sigmaR(ccl_cosmology *cosmo,double R,double a,ccl_f2d_t *psp, int *st
       *status |= gslstatus;
     }
   }
-  gsl_integration_cquad_workspace_free(workspace);
+  ccl_workspace_put_cquad(workspace);
 
   return sqrt(sigma_R*M_LN10/(2*M_PI*M_PI));
 }
@@ -475,7 +476,7 @@ double ccl_sigmaV(ccl_cosmology *cosmo,double R,double a,ccl_f2d_t *psp, int *st
   F.params=&par;
   double sigma_V;
 
-  workspace = gsl_integration_cquad_workspace_alloc(cosmo->gsl_params.N_ITERATION);
+  workspace = ccl_workspace_get_cquad(cosmo->gsl_params.N_ITERATION);
 
   if (workspace == NULL) {
     *status = CCL_ERROR_MEMORY;
@@ -494,7 +495,7 @@ double ccl_sigmaV(ccl_cosmology *cosmo,double R,double a,ccl_f2d_t *psp, int *st
     }
   }
 
-  gsl_integration_cquad_workspace_free(workspace);
+  ccl_workspace_put_cquad(workspace);
 
   return sqrt(sigma_V*M_LN10/(2*M_PI*M_PI));
 }
@@ -541,7 +542,7 @@ double ccl_kNL(ccl_cosmology *cosmo,double a,ccl_f2d_t *psp, int *status) {
   F.params=&par;
   double PL_integral;
 
-  workspace = gsl_integration_cquad_workspace_alloc(cosmo->gsl_params.N_ITERATION);
+  workspace = ccl_workspace_get_cquad(cosmo->gsl_params.N_ITERATION);
   if (workspace == NULL) {
     *status = CCL_ERROR_MEMORY;
   }
@@ -554,7 +555,7 @@ double ccl_kNL(ccl_cosmology *cosmo,double a,ccl_f2d_t *psp, int *status) {
       *status |= gslstatus;
     }
   }
-  gsl_integration_cquad_workspace_free(workspace);
+  ccl_workspace_put_cquad(workspace);
   double sigma_eta = sqrt(PL_integral/(6*M_PI*M_PI));
   return pow(sigma_eta, -1);
 }
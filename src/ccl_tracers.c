@@ -18,6 +18,8 @@ ccl_cl_tracer_collection_t *ccl_cl_tracer_collection_t_new(int *status) {
 
   if (*status == 0) {
     trc->n_tracers = 0;
+    trc->chi_min = 1E15;
+    trc->chi_max = -1E15;
     // Currently CCL_MAX_TRACERS_PER_COLLECTION is hard-coded to 100.
     // It should be enough for any practical application with minimal memory overhead
     trc->ts = malloc(CCL_MAX_TRACERS_PER_COLLECTION*sizeof(ccl_cl_tracer_t *));
@@ -47,6 +49,12 @@ void ccl_add_cl_tracer_to_collection(ccl_cl_tracer_collection_t *trc,
   }
   trc->ts[trc->n_tracers] = tr;
   trc->n_tracers++;
+
+  // Keep track of the radial support of the whole collection
+  if (tr->chi_min < trc->chi_min)
+    trc->chi_min = tr->chi_min;
+  if (tr->chi_max > trc->chi_max)
+    trc->chi_max = tr->chi_max;
 }
 
 //Integrand for N(z) integrator
@@ -687,6 +695,36 @@ ccl_cl_tracer_t *ccl_cl_tracer_t_new(ccl_cosmology *cosmo,
   return tr;
 }
 
+ccl_cl_tracer_t *ccl_cl_tracer_t_new_with_kernel(ccl_cosmology *cosmo,
+                                                 ccl_cl_tracer_t *tr,
+                                                 int n_w, double *chi_w,
+                                                 double *w_w,
+                                                 int *status) {
+  ccl_cl_tracer_t *tr_new = NULL;
+
+  // New kernel and edges, no transfer function yet
+  tr_new = ccl_cl_tracer_t_new(cosmo, tr->der_bessel, tr->der_angles,
+                               n_w, chi_w, w_w,
+                               -1, NULL, -1, NULL, NULL, NULL, NULL,
+                               0, 0, 0, 0, status);
+
+  // Copy the original transfer function
+  if ((*status == 0) && (tr->transfer != NULL)) {
+    tr_new->transfer = ccl_f2d_t_copy(tr->transfer, status);
+    if (tr_new->transfer == NULL) {
+      *status = CCL_ERROR_MEMORY;
+      ccl_cosmology_set_status_message(
+        cosmo,
+        "ccl_tracers.c: ccl_cl_tracer_t_new_with_kernel(): "
+        "could not copy transfer function\n");
+      ccl_cl_tracer_t_free(tr_new);
+      tr_new = NULL;
+    }
+  }
+
+  return tr_new;
+}
+
 void ccl_cl_tracer_t_free(ccl_cl_tracer_t *tr) {
   if (tr != NULL) {
     if (tr->transfer != NULL)
@@ -271,6 +271,123 @@ double ccl_j_bessel(int l,double x)
   return jl;
 }
 
+// Below this argument, j_l(x) is given by the first term of its series
+#define CCL_JL_XSMALL 1E-8
+// Miller's recurrence starts at l_max+sqrt(CCL_JL_MILLER_ACC*l_max)
+#define CCL_JL_MILLER_ACC 200
+// Rescaling threshold for Miller's recurrence
+#define CCL_JL_BIG 1E200
+
+/* ------- ROUTINE: j_bessel_miller ------
+INPUTS: maximum multipole, |x|, exact j_0(|x|) and j_1(|x|), output array
+        and its stride
+TASK: compute j_l(|x|) for all l<=l_max with Miller's downward recurrence,
+      normalised with whichever of j_0 and j_1 is larger
+*/
+static void j_bessel_miller(int l_max, double ax, double j0, double j1,
+                            double *jl, int stride)
+{
+  int l, ll;
+  int l_start = l_max + (int)sqrt(CCL_JL_MILLER_ACC*(l_max+1.)) + 10;
+  double jp = 0, j = 1E-30, jm, norm;
+  double m0 = 0, m1 = 0;
+
+  for(l=l_start; l>0; l--) {
+    // j = j_l, jp = j_{l+1}, jm = j_{l-1}
+    jm = (2*l+1)*j/ax - jp;
+    jp = j;
+    j = jm;
+    if(l-1 <= l_max)
+      jl[(l-1)*stride] = j;
+    if(l == 1)
+      m1 = jp;
+    if(fabs(j) > CCL_JL_BIG) {
+      j /= CCL_JL_BIG;
+      jp /= CCL_JL_BIG;
+      for(ll=l-1; ll<=l_max; ll++)
+        jl[ll*stride] /= CCL_JL_BIG;
+      if(l <= 1)
+        m1 /= CCL_JL_BIG;
+    }
+  }
+  m0 = j;
+
+  if(fabs(j0) > fabs(j1))
+    norm = j0/m0;
+  else
+    norm = j1/m1;
+  for(l=0; l<=l_max; l++)
+    jl[l*stride] *= norm;
+}
+
+/* ------- ROUTINE: ccl_j_bessel_array ------
+INPUTS: maximum multipole, number of arguments, arguments, output array
+TASK: compute the spherical Bessel functions j_l(x) for all 0<=l<=l_max
+      and all x. The upward recurrence, vectorised over x, is used where
+      it is stable (l_max<=|x|), and Miller's downward recurrence
+      elsewhere.
+*/
+void ccl_j_bessel_array(int l_max, int nx, double *x, double *jl,
+                        int *status)
+{
+  int ix, l;
+
+  if((l_max < 0) || (nx < 0)) {
+    *status = CCL_ERROR_INCONSISTENT;
+    return;
+  }
+
+  // j_0 and j_1 in closed form (series for small arguments)
+  #pragma omp simd
+  for(ix=0; ix<nx; ix++) {
+    double ax = fabs(x[ix]);
+    double ax2 = ax*ax;
+    jl[ix] = (ax < 0.1) ? 1-ax2*(1-ax2*(1-ax2*(1-ax2/72)/42)/20)/6 :
+      sin(ax)/ax;
+  }
+  if(l_max == 0)
+    return;
+  #pragma omp simd
+  for(ix=0; ix<nx; ix++) {
+    double ax = fabs(x[ix]);
+    double ax2 = ax*ax;
+    jl[nx+ix] = (ax < 0.2) ? ax*(1-ax2*(1-ax2*(1-ax2*(1-ax2/88)/54)/28)/10)/3 :
+      (sin(ax)/ax-cos(ax))/ax;
+  }
+
+  // Upward recurrence. This is only stable for l<|x|, so the values for
+  // smaller arguments are overwritten below.
+  for(l=1; l<l_max; l++) {
+    double *jlm = jl+(l-1)*nx;
+    double *jl0 = jl+l*nx;
+    double *jlp = jl+(l+1)*nx;
+    #pragma omp simd
+    for(ix=0; ix<nx; ix++) {
+      double ax = fabs(x[ix]);
+      jlp[ix] = (ax > 0) ? (2*l+1)*jl0[ix]/ax-jlm[ix] : 0;
+    }
+  }
+
+  #pragma omp parallel for default(none) shared(l_max, nx, x, jl) \
+                           private(l) schedule(dynamic, 16)
+  for(ix=0; ix<nx; ix++) {
+    double ax = fabs(x[ix]);
+
+    if(ax < CCL_JL_XSMALL) {
+      // j_l(x) = x^l/(2l+1)!!
+      for(l=1; l<=l_max; l++)
+        jl[l*nx+ix] = jl[(l-1)*nx+ix]*ax/(2*l+1);
+    }
+    else if(ax < l_max)
+      j_bessel_miller(l_max, ax, jl[ix], jl[nx+ix], jl+ix, nx);
+
+    if(x[ix] < 0) {
+      for(l=1; l<=l_max; l+=2)
+        jl[l*nx+ix] = -jl[l*nx+ix];
+    }
+  }
+}
+
 void ccl_integ_spline(int ny, int nx,double *x,double **y,
                       double a, double b, double *result,
                       const gsl_interp_type *T, int *status)
@@ -303,16 +420,10 @@ void ccl_integ_spline(int ny, int nx,double *x,double **y,
       gsl_interp_accel *ia = NULL;
       gsl_spline *s = NULL;
 
-      s = gsl_spline_alloc(T, nx);
+      s = ccl_workspace_get_spline(T, nx, &ia);
       if(s == NULL)
         local_status = CCL_ERROR_MEMORY;
 
-      if(!local_status) {
-        ia = gsl_interp_accel_alloc();
-        if(ia == NULL)
-          local_status = CCL_ERROR_MEMORY;
-      }
-
       if(!local_status) {
         #pragma omp for
         for(iy=0; iy<ny; iy++) {
@@ -333,8 +444,7 @@ void ccl_integ_spline(int ny, int nx,double *x,double **y,
 	}
       }
 
-      gsl_spline_free(s);
-      gsl_interp_accel_free(ia);
+      ccl_workspace_put_spline(s, ia);
 
       if (local_status) {
         #pragma omp atomic write
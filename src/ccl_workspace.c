@@ -0,0 +1,276 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <gsl/gsl_integration.h>
+#include <gsl/gsl_roots.h>
+#include <gsl/gsl_spline.h>
+
+#include "ccl.h"
+
+typedef struct {
+  gsl_integration_workspace *w;
+  int w_busy;
+  gsl_integration_cquad_workspace *w_cquad;
+  int w_cquad_busy;
+  gsl_spline *spl;
+  gsl_interp_accel *ia;
+  int spl_busy;
+  gsl_root_fsolver *root;
+  int root_busy;
+  double *buf[CCL_WORKSPACE_NBUF];
+  size_t buf_size[CCL_WORKSPACE_NBUF];
+  int buf_busy[CCL_WORKSPACE_NBUF];
+} ccl_workspace_pool;
+
+// One pool per thread. Without OpenMP this is a single static pool.
+static ccl_workspace_pool pool;
+#pragma omp threadprivate(pool)
+
+gsl_integration_workspace *ccl_workspace_get_integration(size_t n)
+{
+  if(pool.w_busy)
+    return gsl_integration_workspace_alloc(n);
+
+  if((pool.w != NULL) && (pool.w->limit < n)) {
+    gsl_integration_workspace_free(pool.w);
+    pool.w = NULL;
+  }
+  if(pool.w == NULL)
+    pool.w = gsl_integration_workspace_alloc(n);
+  if(pool.w != NULL)
+    pool.w_busy = 1;
+  return pool.w;
+}
+
+void ccl_workspace_put_integration(gsl_integration_workspace *w)
+{
+  if(w == NULL)
+    return;
+  if(w == pool.w)
+    pool.w_busy = 0;
+  else
+    gsl_integration_workspace_free(w);
+}
+
+gsl_integration_cquad_workspace *ccl_workspace_get_cquad(size_t n)
+{
+  if(pool.w_cquad_busy)
+    return gsl_integration_cquad_workspace_alloc(n);
+
+  if((pool.w_cquad != NULL) && (pool.w_cquad->size < n)) {
+    gsl_integration_cquad_workspace_free(pool.w_cquad);
+    pool.w_cquad = NULL;
+  }
+  if(pool.w_cquad == NULL)
+    pool.w_cquad = gsl_integration_cquad_workspace_alloc(n);
+  if(pool.w_cquad != NULL)
+    pool.w_cquad_busy = 1;
+  return pool.w_cquad;
+}
+
+void ccl_workspace_put_cquad(gsl_integration_cquad_workspace *w)
+{
+  if(w == NULL)
+    return;
+  if(w == pool.w_cquad)
+    pool.w_cquad_busy = 0;
+  else
+    gsl_integration_cquad_workspace_free(w);
+}
+
+gsl_spline *ccl_workspace_get_spline(const gsl_interp_type *T, size_t n,
+                                     gsl_interp_accel **ia)
+{
+  gsl_spline *s = NULL;
+
+  *ia = NULL;
+  if(pool.spl_busy) {
+    s = gsl_spline_alloc(T, n);
+    if(s != NULL) {
+      *ia = gsl_interp_accel_alloc();
+      if(*ia == NULL) {
+        gsl_spline_free(s);
+        s = NULL;
+      }
+    }
+    return s;
+  }
+
+  // GSL splines can only be initialized with exactly as many knots
+  // as they were allocated with.
+  if((pool.spl != NULL) &&
+     ((pool.spl->size != n) || (pool.spl->interp->type != T))) {
+    gsl_spline_free(pool.spl);
+    pool.spl = NULL;
+  }
+  if(pool.spl == NULL)
+    pool.spl = gsl_spline_alloc(T, n);
+  if(pool.ia == NULL)
+    pool.ia = gsl_interp_accel_alloc();
+  if((pool.spl == NULL) || (pool.ia == NULL))
+    return NULL;
+
+  gsl_interp_accel_reset(pool.ia);
+  pool.spl_busy = 1;
+  *ia = pool.ia;
+  return pool.spl;
+}
+
+void ccl_workspace_put_spline(gsl_spline *s, gsl_interp_accel *ia)
+{
+  if((s != NULL) && (s == pool.spl)) {
+    pool.spl_busy = 0;
+    return;
+  }
+  gsl_spline_free(s);
+  gsl_interp_accel_free(ia);
+}
+
+gsl_root_fsolver *ccl_workspace_get_root_fsolver(const gsl_root_fsolver_type *T)
+{
+  if(pool.root_busy)
+    return gsl_root_fsolver_alloc(T);
+
+  if((pool.root != NULL) && (pool.root->type != T)) {
+    gsl_root_fsolver_free(pool.root);
+    pool.root = NULL;
+  }
+  if(pool.root == NULL)
+    pool.root = gsl_root_fsolver_alloc(T);
+  if(pool.root != NULL)
+    pool.root_busy = 1;
+  return pool.root;
+}
+
+void ccl_workspace_put_root_fsolver(gsl_root_fsolver *s)
+{
+  if(s == NULL)
+    return;
+  if(s == pool.root)
+    pool.root_busy = 0;
+  else
+    gsl_root_fsolver_free(s);
+}
+
+double *ccl_workspace_get_doubles(size_t n)
+{
+  int ib;
+
+  // Prefer a free buffer that is already large enough.
+  for(ib=0; ib<CCL_WORKSPACE_NBUF; ib++) {
+    if((!pool.buf_busy[ib]) && (pool.buf[ib] != NULL) &&
+       (pool.buf_size[ib] >= n)) {
+      pool.buf_busy[ib] = 1;
+      return pool.buf[ib];
+    }
+  }
+
+  // Otherwise grow the first free one.
+  for(ib=0; ib<CCL_WORKSPACE_NBUF; ib++) {
+    if(!pool.buf_busy[ib]) {
+      double *buf = realloc(pool.buf[ib], n*sizeof(double));
+      if(buf == NULL)
+        return NULL;
+      pool.buf[ib] = buf;
+      pool.buf_size[ib] = n;
+      pool.buf_busy[ib] = 1;
+      return buf;
+    }
+  }
+
+  return malloc(n*sizeof(double));
+}
+
+void ccl_workspace_put_doubles(double *buf)
+{
+  int ib;
+
+  if(buf == NULL)
+    return;
+  for(ib=0; ib<CCL_WORKSPACE_NBUF; ib++) {
+    if(buf == pool.buf[ib]) {
+      pool.buf_busy[ib] = 0;
+      return;
+    }
+  }
+  free(buf);
+}
+
+/* ------- ROUTINE: ccl_workspace_reserve ------
+INPUTS: number of integration intervals, size of the scratch buffers
+TASK: allocate the integration workspaces and scratch buffers of all threads
+*/
+void ccl_workspace_reserve(size_t n_intervals, size_t n_doubles, int *status)
+{
+  #pragma omp parallel default(none) \
+                       shared(n_intervals, n_doubles, status)
+  {
+    int ib;
+    int local_status = 0;
+    gsl_integration_workspace *w = NULL;
+    gsl_integration_cquad_workspace *w_cquad = NULL;
+    double *bufs[CCL_WORKSPACE_NBUF];
+
+    w = ccl_workspace_get_integration(n_intervals);
+    w_cquad = ccl_workspace_get_cquad(n_intervals);
+    if((w == NULL) || (w_cquad == NULL))
+      local_status = CCL_ERROR_MEMORY;
+    ccl_workspace_put_integration(w);
+    ccl_workspace_put_cquad(w_cquad);
+
+    if(n_doubles > 0) {
+      // Take all the buffers at once so each one gets resized.
+      for(ib=0; ib<CCL_WORKSPACE_NBUF; ib++) {
+        bufs[ib] = ccl_workspace_get_doubles(n_doubles);
+        if(bufs[ib] == NULL)
+          local_status = CCL_ERROR_MEMORY;
+      }
+      for(ib=0; ib<CCL_WORKSPACE_NBUF; ib++)
+        ccl_workspace_put_doubles(bufs[ib]);
+    }
+
+    if(local_status) {
+      #pragma omp atomic write
+      *status = local_status;
+    }
+  } //end omp parallel
+}
+
+void ccl_workspace_release(void)
+{
+  int ib;
+
+  if(!pool.w_busy) {
+    gsl_integration_workspace_free(pool.w);
+    pool.w = NULL;
+  }
+  if(!pool.w_cquad_busy) {
+    gsl_integration_cquad_workspace_free(pool.w_cquad);
+    pool.w_cquad = NULL;
+  }
+  if(!pool.spl_busy) {
+    gsl_spline_free(pool.spl);
+    gsl_interp_accel_free(pool.ia);
+    pool.spl = NULL;
+    pool.ia = NULL;
+  }
+  if(!pool.root_busy) {
+    gsl_root_fsolver_free(pool.root);
+    pool.root = NULL;
+  }
+  for(ib=0; ib<CCL_WORKSPACE_NBUF; ib++) {
+    if(!pool.buf_busy[ib]) {
+      free(pool.buf[ib]);
+      pool.buf[ib] = NULL;
+      pool.buf_size[ib] = 0;
+    }
+  }
+}
+
+void ccl_workspace_release_all(void)
+{
+  #pragma omp parallel
+  {
+    ccl_workspace_release();
+  } //end omp parallel
+}